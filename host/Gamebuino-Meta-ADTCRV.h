@@ -0,0 +1,226 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#ifndef SST_HOST_GAMEBUINO_H
+#define SST_HOST_GAMEBUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* The part of the Gamebuino META library that the game uses, implemented on the host. The display is drawn
+ * in memory, update() never waits and every frame is handed over to a spaceshoot::host::FrameSink.
+ * The display can be indexed or rgb565 (the low resolution profile), only the indexed one can be drawn on. */
+
+enum class ColorMode : uint8_t {
+    rgb565,
+    index
+};
+
+enum class Color : uint16_t {
+    black = 0x0000,
+    white = 0xFFFF
+};
+
+enum class ColorIndex : uint8_t {
+    black, darkblue, purple, green, brown, darkgray, gray, white,
+    red, orange, yellow, lightgreen, lightblue, blue, pink, beige
+};
+
+const ColorIndex INDEX_BLACK = ColorIndex::black;
+const ColorIndex INDEX_DARKBLUE = ColorIndex::darkblue;
+const ColorIndex INDEX_PURPLE = ColorIndex::purple;
+const ColorIndex INDEX_GREEN = ColorIndex::green;
+const ColorIndex INDEX_BROWN = ColorIndex::brown;
+const ColorIndex INDEX_DARKGRAY = ColorIndex::darkgray;
+const ColorIndex INDEX_GRAY = ColorIndex::gray;
+const ColorIndex INDEX_WHITE = ColorIndex::white;
+const ColorIndex INDEX_RED = ColorIndex::red;
+const ColorIndex INDEX_ORANGE = ColorIndex::orange;
+const ColorIndex INDEX_YELLOW = ColorIndex::yellow;
+const ColorIndex INDEX_LIGHTGREEN = ColorIndex::lightgreen;
+const ColorIndex INDEX_LIGHTBLUE = ColorIndex::lightblue;
+const ColorIndex INDEX_BLUE = ColorIndex::blue;
+const ColorIndex INDEX_PINK = ColorIndex::pink;
+const ColorIndex INDEX_BEIGE = ColorIndex::beige;
+
+enum class Button : uint8_t {
+    down, left, right, up, a, b, menu, home
+};
+
+const Button BUTTON_DOWN = Button::down;
+const Button BUTTON_LEFT = Button::left;
+const Button BUTTON_RIGHT = Button::right;
+const Button BUTTON_UP = Button::up;
+const Button BUTTON_A = Button::a;
+const Button BUTTON_B = Button::b;
+const Button BUTTON_MENU = Button::menu;
+const Button BUTTON_HOME = Button::home;
+const uint8_t NUM_BUTTONS = 8;
+
+namespace Gamebuino_Meta {
+
+    struct RGB888 {
+        uint8_t r;
+        uint8_t g;
+        uint8_t b;
+    };
+
+    RGB888 rgb565Torgb888(uint16_t color);
+    uint16_t rgb888Torgb565(RGB888 color);
+
+    extern const Color defaultColorPalette[16];
+
+    /* The host transfers are synchronous, all descriptors are always free */
+    extern volatile uint32_t dma_desc_free_count;
+}
+
+/* Images in the library format: width, height, frames (16 bits), frame loop, transparent color index and
+ * color mode, then the pixels. Only single frame indexed images are drawn. The display is either indexed or
+ * rgb565, the drawing functions only handle the indexed one. */
+class Image {
+public:
+    uint16_t* _buffer;
+    ColorMode colorMode;
+
+    Image();
+    Image(const uint8_t* data);
+    void init(const uint8_t* data);
+    void init(uint16_t width, uint16_t height, ColorMode mode);
+
+    uint16_t width();
+    uint16_t height();
+
+    void clear();
+    void setColor(ColorIndex color);
+    void setColor(uint8_t color);
+    void setPalette(const Color* palette);
+
+    void drawPixel(int16_t x, int16_t y);
+    void drawPixel(int16_t x, int16_t y, ColorIndex color);
+    void drawFastVLine(int16_t x, int16_t y, int16_t h);
+    void drawFastHLine(int16_t x, int16_t y, int16_t w);
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h);
+    void drawImage(int16_t x, int16_t y, Image& image);
+    void drawImage(int16_t x, int16_t y, Image& image, int16_t srcX, int16_t srcY, int16_t w, int16_t h);
+
+    void setFont(const uint8_t* font);
+    void setFontSize(uint8_t sizeW, uint8_t sizeH);
+    void setCursor(int16_t x, int16_t y);
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint8_t size);
+    void print(const char* str);
+    void print(int16_t x, int16_t y, const char* str);
+    void printf(const char* format, ...);
+    void printf(int16_t x, int16_t y, const char* format, ...);
+
+private:
+    const uint8_t* data;            /* For images loaded from flash, nullptr for the display */
+    uint16_t imageWidth;
+    uint16_t imageHeight;
+    uint8_t transparentColor;
+
+    uint8_t color;
+    const uint8_t* font;
+    uint8_t fontSizeW;
+    uint8_t fontSizeH;
+    int16_t cursorX;
+    int16_t cursorY;
+
+    void setPixel(int16_t x, int16_t y, uint8_t index);
+    uint8_t getPixel(int16_t x, int16_t y) const;
+};
+
+struct ColorCells {
+    bool enabled;
+    uint8_t* paletteToLine;
+    Color** palettes;
+};
+
+/* The panel: the framebuffer is resolved into it at every update() while the display has a buffer, sendBuffer()
+ * writes into it directly */
+class Tft {
+public:
+    ColorCells colorCells;
+
+    void setPalette(const Color* palette);
+    void setAddrWindow(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+    void commandMode();
+    void dataMode();
+    void idleMode();
+    /* Pixels are big endian, like on the SPI bus */
+    void sendBuffer(uint16_t* buffer, uint16_t count);
+};
+
+class Lights {
+public:
+    void drawPixel(uint8_t x, uint8_t y, Color color);
+    void clear();
+    void fill(Color color);
+};
+
+class Sound {
+public:
+    int8_t tone(uint32_t frequency, int32_t duration = 0);
+};
+
+/* states[button]: 0 when released, then the number of frames it has been held */
+class Buttons {
+public:
+    uint16_t states[NUM_BUTTONS];
+
+    bool pressed(Button button);
+    bool released(Button button);
+    bool repeat(Button button, uint16_t period);
+};
+
+class Bootloader {
+public:
+    void loader();
+};
+
+class Gamebuino {
+public:
+    Image display;
+    Tft tft;
+    Lights lights;
+    Sound sound;
+    Buttons buttons;
+    Bootloader bootloader;
+
+    uint32_t frameCount;
+    uint32_t frameDurationMicros;
+
+    void begin();
+    void setFrameRate(uint8_t fps);
+    /* Ends the frame and starts the next one right away */
+    bool update();
+    uint8_t getCpuLoad();
+};
+
+extern Gamebuino gb;
+
+uint32_t micros();
+uint32_t millis();
+
+#endif // SST_HOST_GAMEBUINO_H
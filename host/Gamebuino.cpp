@@ -0,0 +1,493 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#include "Gamebuino-Meta-ADTCRV.h"
+#include "Host.h"
+#include "SPI.h"
+#include "TitleSoundtrack.h"
+#include <stdarg.h>
+#include <chrono>
+
+Gamebuino gb;
+SPIClass SPI;
+
+namespace Gamebuino_Meta {
+
+    const Color defaultColorPalette[16] = {
+        (Color)0x0000, (Color)0x194a, (Color)0x792a, (Color)0x042a,
+        (Color)0xaa86, (Color)0x5aa9, (Color)0xc618, (Color)0xffff,
+        (Color)0xf809, (Color)0xfd00, (Color)0xff64, (Color)0x0727,
+        (Color)0x2d7f, (Color)0x83b3, (Color)0xfbb5, (Color)0xfe75
+    };
+
+    volatile uint32_t dma_desc_free_count = 3;
+
+    RGB888 rgb565Torgb888(uint16_t color) {
+        return { (uint8_t)((color >> 11) << 3), (uint8_t)(((color >> 5) & 0x3F) << 2), (uint8_t)((color & 0x1F) << 3) };
+    }
+
+    uint16_t rgb888Torgb565(RGB888 color) {
+        return ((color.r >> 3) << 11) | ((color.g >> 2) << 5) | (color.b >> 3);
+    }
+}
+
+namespace title_soundtrack {
+    void play() {
+    }
+}
+
+namespace spaceshoot { namespace host {
+
+    /* As read by the library: the converted images carry one more byte, which ends up as their first two pixels */
+    const size_t IMAGE_HEADER_SIZE = 7;
+
+    static uint8_t framebuffer[PANEL_WIDTH * PANEL_HEIGHT / 2];
+    static uint16_t panel[PANEL_WIDTH * PANEL_HEIGHT];
+    static const Color* palette = Gamebuino_Meta::defaultColorPalette;
+
+    /* The address window of the panel and the next pixel written into it */
+    static int16_t windowX0, windowY0, windowX1, windowY1;
+    static int16_t panelX, panelY;
+
+    static FrameSink* frameSink;
+    static uint64_t panelBytes;
+    static uint32_t frameLimit;
+    static void (*frameLimitAtExit)();
+
+    struct ScriptedButton {
+        Button button;
+        uint32_t first;
+        uint16_t frames;
+    };
+    static std::vector<ScriptedButton> script;
+
+    static const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    static uint32_t frameStartMicros;
+    static uint32_t virtualFrameMicros;
+    static uint32_t virtualMicros;
+
+    void setFrameSink(FrameSink* sink) {
+        frameSink = sink;
+    }
+
+    uint64_t bytesSent() {
+        return panelBytes;
+    }
+
+    void holdButton(Button button, uint32_t first, uint16_t frames) {
+        script.push_back({ button, first, frames });
+    }
+
+    void useVirtualClock(uint32_t frameMicros) {
+        virtualFrameMicros = frameMicros;
+        virtualMicros = 0;
+        frameStartMicros = 0;
+    }
+
+    void setFrameLimit(uint32_t frames, void (*atExit)()) {
+        frameLimit = frames;
+        frameLimitAtExit = atExit;
+    }
+
+    static bool scriptedDown(Button button, uint32_t frame) {
+        for (const ScriptedButton& entry : script) {
+            if (entry.button == button && frame >= entry.first && frame < entry.first + entry.frames) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static void updateButtons(uint32_t frame) {
+        for (uint8_t ix = 0; ix < NUM_BUTTONS; ix++) {
+            uint16_t& state = gb.buttons.states[ix];
+            if (scriptedDown((Button)ix, frame)) {
+                state = (state == 0 || state >= 0xFFFE) ? 1 : (state < 0xFFFD ? state + 1 : state);
+            } else {
+                state = (state == 0 || state >= 0xFFFE) ? 0 : 0xFFFF;
+            }
+        }
+    }
+
+    static void resolveFramebuffer() {
+        const uint16_t width = gb.display.width();
+        const uint16_t height = gb.display.height();
+        const ColorCells& cells = gb.tft.colorCells;
+
+        for (uint16_t y = 0; y < height && y < PANEL_HEIGHT; y++) {
+            const Color* linePalette = palette;
+            if (cells.enabled && cells.paletteToLine != nullptr && cells.palettes[cells.paletteToLine[y]] != nullptr) {
+                linePalette = cells.palettes[cells.paletteToLine[y]];
+            }
+            for (uint16_t x = 0; x < width && x < PANEL_WIDTH; x++) {
+                const uint8_t byte = framebuffer[y * (width / 2) + (x >> 1)];
+                panel[y * PANEL_WIDTH + x] = (uint16_t)linePalette[(x & 0x01) ? (byte & 0x0F) : (byte >> 4)];
+            }
+        }
+    }
+
+    /* As the library does with an 80x64 display: every pixel doubled in both directions */
+    static void upscaleFramebuffer() {
+        const uint16_t width = gb.display.width();
+        const uint16_t height = gb.display.height();
+
+        for (uint16_t y = 0; y < height * 2 && y < PANEL_HEIGHT; y++) {
+            const uint16_t* line = gb.display._buffer + (y >> 1) * width;
+            for (uint16_t x = 0; x < width * 2 && x < PANEL_WIDTH; x++) {
+                panel[y * PANEL_WIDTH + x] = line[x >> 1];
+            }
+        }
+    }
+
+    /* The display is sent whole while it has a buffer. Its buffer may also be taken away for the duration of
+     * update(), with the picture sent line by line beforehand. */
+    static void endFrame() {
+        const bool rgb565 = gb.display.colorMode == ColorMode::rgb565;
+        const bool sent = gb.display._buffer != nullptr;
+
+        Frame frame;
+        frame.number = gb.frameCount;
+        frame.width = gb.display.width();
+        frame.height = gb.display.height();
+        frame.indexed = frame.width > 0 && !rgb565 ? framebuffer : nullptr;
+        frame.paletteToLine = gb.tft.colorCells.enabled ? gb.tft.colorCells.paletteToLine : nullptr;
+        frame.rgb565 = panel;
+
+        if (sent) {
+            if (rgb565) {
+                upscaleFramebuffer();
+            } else {
+                resolveFramebuffer();
+            }
+            panelBytes += PANEL_WIDTH * PANEL_HEIGHT * sizeof(uint16_t);
+        }
+        if (frameSink != nullptr) {
+            frameSink->write(frame);
+        }
+    }
+
+}} // namespace spaceshoot::host
+
+using namespace spaceshoot::host;
+
+Image::Image() : _buffer(nullptr), colorMode(ColorMode::index), data(nullptr), imageWidth(0), imageHeight(0),
+        transparentColor(0xFF),
+        color(0), font(nullptr), fontSizeW(1), fontSizeH(1), cursorX(0), cursorY(0) {
+}
+
+Image::Image(const uint8_t* data) : Image() {
+    init(data);
+}
+
+void Image::init(const uint8_t* data) {
+    this->data = data;
+    _buffer = nullptr;
+    imageWidth = data[0];
+    imageHeight = data[1];
+    transparentColor = data[5];
+}
+
+void Image::init(uint16_t width, uint16_t height, ColorMode mode) {
+    const size_t bytes = mode == ColorMode::rgb565 ? width * height * 2 : width * height / 2;
+    if ((mode != ColorMode::index && mode != ColorMode::rgb565) || bytes > sizeof(framebuffer)) {
+        fprintf(stderr, "Unsupported display mode %ux%u\n", width, height);
+        exit(1);
+    }
+    data = nullptr;
+    imageWidth = width;
+    imageHeight = height;
+    colorMode = mode;
+    _buffer = width > 0 ? reinterpret_cast<uint16_t*>(framebuffer) : nullptr;
+}
+
+uint16_t Image::width() {
+    return imageWidth;
+}
+
+uint16_t Image::height() {
+    return imageHeight;
+}
+
+void Image::setPixel(int16_t x, int16_t y, uint8_t index) {
+    if (_buffer == nullptr || colorMode != ColorMode::index || x < 0 || y < 0 || x >= imageWidth || y >= imageHeight) {
+        return;
+    }
+    uint8_t& byte = framebuffer[y * (imageWidth / 2) + (x >> 1)];
+    byte = (x & 0x01) ? (byte & 0xF0) | index : (byte & 0x0F) | (index << 4);
+}
+
+uint8_t Image::getPixel(int16_t x, int16_t y) const {
+    const uint8_t byte = data[IMAGE_HEADER_SIZE + y * ((imageWidth + 1) / 2) + (x >> 1)];
+    return (x & 0x01) ? (byte & 0x0F) : (byte >> 4);
+}
+
+void Image::clear() {
+    if (_buffer != nullptr) {
+        memset(framebuffer, 0, colorMode == ColorMode::rgb565 ? imageWidth * imageHeight * 2 : imageWidth * imageHeight / 2);
+    }
+}
+
+void Image::setColor(ColorIndex color) {
+    this->color = (uint8_t)color & 0x0F;
+}
+
+void Image::setColor(uint8_t color) {
+    this->color = color & 0x0F;
+}
+
+void Image::setPalette(const Color* palette) {
+    spaceshoot::host::palette = palette;
+}
+
+void Image::drawPixel(int16_t x, int16_t y) {
+    setPixel(x, y, color);
+}
+
+void Image::drawPixel(int16_t x, int16_t y, ColorIndex color) {
+    setPixel(x, y, (uint8_t)color);
+}
+
+void Image::drawFastVLine(int16_t x, int16_t y, int16_t h) {
+    fillRect(x, y, 1, h);
+}
+
+void Image::drawFastHLine(int16_t x, int16_t y, int16_t w) {
+    fillRect(x, y, w, 1);
+}
+
+void Image::fillRect(int16_t x, int16_t y, int16_t w, int16_t h) {
+    for (int16_t py = y; py < y + h; py++) {
+        for (int16_t px = x; px < x + w; px++) {
+            setPixel(px, py, color);
+        }
+    }
+}
+
+void Image::drawImage(int16_t x, int16_t y, Image& image) {
+    drawImage(x, y, image, 0, 0, image.imageWidth, image.imageHeight);
+}
+
+void Image::drawImage(int16_t x, int16_t y, Image& image, int16_t srcX, int16_t srcY, int16_t w, int16_t h) {
+    if (image.data == nullptr) {
+        return;
+    }
+    for (int16_t py = 0; py < h; py++) {
+        for (int16_t px = 0; px < w; px++) {
+            const uint8_t index = image.getPixel(srcX + px, srcY + py);
+            if (index != image.transparentColor) {
+                setPixel(x + px, y + py, index);
+            }
+        }
+    }
+}
+
+void Image::setFont(const uint8_t* font) {
+    this->font = font;
+}
+
+void Image::setFontSize(uint8_t sizeW, uint8_t sizeH) {
+    fontSizeW = sizeW;
+    fontSizeH = sizeH;
+}
+
+void Image::setCursor(int16_t x, int16_t y) {
+    cursorX = x;
+    cursorY = y;
+}
+
+/* The fonts have 128 characters, a byte per column, the top row in bit 0 */
+void Image::drawChar(int16_t x, int16_t y, unsigned char c, uint8_t) {
+    if (font == nullptr || c >= 128) {
+        return;
+    }
+    const uint8_t* glyph = font + 2 + c * font[0];
+    for (uint8_t column = 0; column < font[0]; column++) {
+        for (uint8_t row = 0; row < font[1]; row++) {
+            if (glyph[column] & (1 << row)) {
+                for (uint8_t sy = 0; sy < fontSizeH; sy++) {
+                    for (uint8_t sx = 0; sx < fontSizeW; sx++) {
+                        setPixel(x + column * fontSizeW + sx, y + row * fontSizeH + sy, color);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/* '\n' starts a new line, '\r' is ignored, and the text wraps once the next character would not fit */
+void Image::print(const char* str) {
+    if (font == nullptr) {
+        return;
+    }
+    const int16_t advanceX = (font[0] + 1) * fontSizeW;
+    const int16_t advanceY = (font[1] + 1) * fontSizeH;
+
+    for (; *str; str++) {
+        if (*str == '\n') {
+            cursorX = 0;
+            cursorY += advanceY;
+            continue;
+        }
+        if (*str == '\r') {
+            continue;
+        }
+
+        drawChar(cursorX, cursorY, *str, 1);
+        cursorX += advanceX;
+        if (cursorX > (int16_t)imageWidth - advanceX) {
+            cursorX = 0;
+            cursorY += advanceY;
+        }
+    }
+}
+
+void Image::print(int16_t x, int16_t y, const char* str) {
+    setCursor(x, y);
+    print(str);
+}
+
+void Image::printf(const char* format, ...) {
+    char str[128];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(str, sizeof(str), format, args);
+    va_end(args);
+    print(str);
+}
+
+void Image::printf(int16_t x, int16_t y, const char* format, ...) {
+    char str[128];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(str, sizeof(str), format, args);
+    va_end(args);
+    print(x, y, str);
+}
+
+void Tft::setPalette(const Color* palette) {
+    spaceshoot::host::palette = palette;
+}
+
+void Tft::setAddrWindow(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    windowX0 = x0;
+    windowY0 = y0;
+    windowX1 = x1;
+    windowY1 = y1;
+    panelX = x0;
+    panelY = y0;
+}
+
+void Tft::commandMode() {
+}
+
+void Tft::dataMode() {
+}
+
+void Tft::idleMode() {
+}
+
+void Tft::sendBuffer(uint16_t* buffer, uint16_t count) {
+    panelBytes += count * sizeof(uint16_t);
+    for (uint16_t ix = 0; ix < count; ix++) {
+        if (panelX < PANEL_WIDTH && panelY < PANEL_HEIGHT) {
+            panel[panelY * PANEL_WIDTH + panelX] = (buffer[ix] >> 8) | (buffer[ix] << 8);
+        }
+        if (++panelX > windowX1) {
+            panelX = windowX0;
+            if (++panelY > windowY1) {
+                panelY = windowY0;
+            }
+        }
+    }
+}
+
+void Lights::drawPixel(uint8_t, uint8_t, Color) {
+}
+
+void Lights::clear() {
+}
+
+void Lights::fill(Color) {
+}
+
+int8_t Sound::tone(uint32_t, int32_t) {
+    return -1;
+}
+
+bool Buttons::pressed(Button button) {
+    return states[(uint8_t)button] == 1;
+}
+
+bool Buttons::released(Button button) {
+    return states[(uint8_t)button] == 0xFFFF;
+}
+
+bool Buttons::repeat(Button button, uint16_t period) {
+    const uint16_t state = states[(uint8_t)button];
+    return state != 0 && state < 0xFFFE && (period == 0 ? state == 1 : (state % period) == 1);
+}
+
+void Bootloader::loader() {
+    exit(0);
+}
+
+void Gamebuino::begin() {
+    frameStartMicros = micros();
+}
+
+void Gamebuino::setFrameRate(uint8_t) {
+}
+
+bool Gamebuino::update() {
+    endFrame();
+    virtualMicros += virtualFrameMicros;
+
+    const uint32_t now = micros();
+    frameDurationMicros = now - frameStartMicros;
+    frameStartMicros = now;
+
+    frameCount++;
+    if (frameLimit != 0 && frameCount >= frameLimit) {
+        if (frameLimitAtExit != nullptr) {
+            frameLimitAtExit();
+        }
+        exit(0);
+    }
+
+    updateButtons(frameCount);
+    return true;
+}
+
+uint8_t Gamebuino::getCpuLoad() {
+    return 0;
+}
+
+uint32_t micros() {
+    if (virtualFrameMicros != 0) {
+        return virtualMicros;
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+uint32_t millis() {
+    return micros() / 1000;
+}
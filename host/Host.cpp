@@ -0,0 +1,343 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#include "Host.h"
+#include "Utils.h"
+#include <stdio.h>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace spaceshoot { namespace host {
+
+    FileSink::FileSink(const char* directory, uint32_t every) : directory(directory), every(every > 0 ? every : 1) {
+    }
+
+    static FILE* openFrameFile(const char* directory, uint32_t number, const char* extension) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%06u.%s", directory, (unsigned int)number, extension);
+        FILE* file = fopen(path, "wb");
+        if (file == nullptr) {
+            fprintf(stderr, "Cannot write %s\n", path);
+        }
+        return file;
+    }
+
+    static void toRgb24(const uint16_t* rgb565, uint8_t* dest) {
+        for (size_t ix = 0; ix < (size_t)PANEL_WIDTH * PANEL_HEIGHT; ix++) {
+            const Gamebuino_Meta::RGB888 color = Gamebuino_Meta::rgb565Torgb888(rgb565[ix]);
+            *dest++ = color.r;
+            *dest++ = color.g;
+            *dest++ = color.b;
+        }
+    }
+
+    /* Whole pictures at once, the files are written by many workers when exporting */
+    void FileSink::write(const Frame& frame) {
+        if (frame.number % every != 0) {
+            return;
+        }
+
+        if (frame.indexed != nullptr) {
+            FILE* file = openFrameFile(directory, frame.number, "pgm");
+            if (file != nullptr) {
+                std::vector<uint8_t> pixels((size_t)frame.width * frame.height);
+                for (size_t ix = 0; ix < pixels.size(); ix++) {
+                    const uint8_t byte = frame.indexed[ix >> 1];
+                    pixels[ix] = (ix & 0x01) ? (byte & 0x0F) : (byte >> 4);
+                }
+                fprintf(file, "P5\n%u %u\n15\n", frame.width, frame.height);
+                fwrite(pixels.data(), 1, pixels.size(), file);
+                fclose(file);
+            }
+        }
+
+        FILE* file = openFrameFile(directory, frame.number, "ppm");
+        if (file != nullptr) {
+            uint8_t pixels[RawVideoSink::FRAME_BYTES];
+            toRgb24(frame.rgb565, pixels);
+            fprintf(file, "P6\n%u %u\n255\n", PANEL_WIDTH, PANEL_HEIGHT);
+            fwrite(pixels, 1, sizeof(pixels), file);
+            fclose(file);
+        }
+    }
+
+    RawVideoSink::RawVideoSink(const char* path, uint32_t every) : every(every > 0 ? every : 1) {
+        fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            perror(path);
+        }
+    }
+
+    RawVideoSink::~RawVideoSink() {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+
+    void RawVideoSink::write(const Frame& frame) {
+        if (fd < 0 || frame.number % every != 0) {
+            return;
+        }
+        uint8_t pixels[FRAME_BYTES];
+        toRgb24(frame.rgb565, pixels);
+        if (pwrite(fd, pixels, sizeof(pixels), (off_t)(frame.number / every) * FRAME_BYTES) != (ssize_t)sizeof(pixels)) {
+            perror("Cannot write the video");
+        }
+    }
+
+    ExportSink::ExportSink(FrameSink& output, uint32_t keyframeInterval, unsigned int jobs) : output(output),
+            keyframeInterval(keyframeInterval > 0 ? keyframeInterval : 1), jobs(jobs > 0 ? jobs : 1),
+            nextKeyframe(0), worker(false), failed(false) {
+    }
+
+    void ExportSink::write(const Frame& frame) {
+        if (worker) {
+            if (frame.number >= nextKeyframe) {
+                finish();
+            }
+            output.write(frame);
+            return;
+        }
+        if (frame.number < nextKeyframe) {
+            return;
+        }
+
+        nextKeyframe = (frame.number / keyframeInterval + 1) * keyframeInterval;
+        while (workers.size() >= jobs) {
+            waitForWorker();
+        }
+        /* Anything buffered would be printed by the worker as well */
+        fflush(stdout);
+        fflush(stderr);
+        const pid_t pid = fork();
+        if (pid == 0) {
+            worker = true;
+            workers.clear();
+            output.write(frame);
+        } else if (pid < 0) {
+            perror("fork");
+            output.write(frame);
+            failed = true;
+        } else {
+            workers.push_back(pid);
+        }
+    }
+
+    void ExportSink::waitForWorker() {
+        int status;
+        const pid_t pid = wait(&status);
+        if (pid < 0) {
+            workers.clear();
+            return;
+        }
+        for (size_t ix = 0; ix < workers.size(); ix++) {
+            if (workers[ix] == pid) {
+                workers.erase(workers.begin() + ix);
+                break;
+            }
+        }
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            failed = true;
+        }
+    }
+
+    bool ExportSink::finish() {
+        if (worker) {
+            _exit(0);
+        }
+        while (!workers.empty()) {
+            waitForWorker();
+        }
+        return !failed;
+    }
+
+    void MemorySink::write(const Frame& frame) {
+        Stored stored;
+        stored.number = frame.number;
+        if (frame.indexed != nullptr) {
+            stored.indexed.assign(frame.indexed, frame.indexed + (size_t)frame.width * frame.height / 2);
+        }
+        stored.rgb565.assign(frame.rgb565, frame.rgb565 + (size_t)PANEL_WIDTH * PANEL_HEIGHT);
+        frames.push_back(stored);
+    }
+
+    static uint8_t fold(uint32_t hash) {
+        return hash ^ (hash >> 8) ^ (hash >> 16) ^ (hash >> 24);
+    }
+
+    static GoldenSink::Hashes hashFrame(const Frame& frame) {
+        GoldenSink::Hashes hashes;
+        hashes.number = frame.number;
+        hashes.indexed = frame.indexed != nullptr ?
+                hashFnv1a(FNV_OFFSET, frame.indexed, (size_t)frame.width * frame.height / 2) : 0;
+        hashes.paletteToLine = frame.paletteToLine != nullptr ?
+                hashFnv1a(FNV_OFFSET, frame.paletteToLine, PANEL_HEIGHT) : 0;
+        hashes.panel = hashFnv1a(FNV_OFFSET, (const uint8_t*)frame.rgb565, sizeof(uint16_t) * PANEL_WIDTH * PANEL_HEIGHT);
+
+        const uint16_t bandHeight = PANEL_HEIGHT / GoldenSink::BANDS;
+        const uint16_t bandWidth = PANEL_WIDTH / GoldenSink::BANDS;
+        uint32_t columns[GoldenSink::BANDS];
+        for (uint8_t band = 0; band < GoldenSink::BANDS; band++) {
+            columns[band] = FNV_OFFSET;
+        }
+        for (uint8_t band = 0; band < GoldenSink::BANDS; band++) {
+            const uint16_t* lines = frame.rgb565 + band * bandHeight * PANEL_WIDTH;
+            hashes.rows[band] = fold(hashFnv1a(FNV_OFFSET, (const uint8_t*)lines, sizeof(uint16_t) * bandHeight * PANEL_WIDTH));
+            for (uint16_t y = 0; y < bandHeight; y++) {
+                for (uint8_t column = 0; column < GoldenSink::BANDS; column++) {
+                    columns[column] = hashFnv1a(columns[column], (const uint8_t*)(lines + y * PANEL_WIDTH + column * bandWidth),
+                            sizeof(uint16_t) * bandWidth);
+                }
+            }
+        }
+        for (uint8_t band = 0; band < GoldenSink::BANDS; band++) {
+            hashes.columns[band] = fold(columns[band]);
+        }
+        return hashes;
+    }
+
+    static bool parseBands(const char* hex, uint8_t* bands) {
+        for (uint8_t band = 0; band < GoldenSink::BANDS; band++) {
+            unsigned int value;
+            if (sscanf(hex + band * 2, "%2x", &value) != 1) {
+                return false;
+            }
+            bands[band] = value;
+        }
+        return true;
+    }
+
+    GoldenSink::GoldenSink(const char* path, Mode mode) : path(path), mode(mode), mismatch(false) {
+        if (mode != Check) {
+            return;
+        }
+
+        FILE* file = fopen(path, "r");
+        if (file == nullptr) {
+            fprintf(stderr, "Cannot read %s\n", path);
+            mismatch = true;
+            return;
+        }
+        char line[256];
+        while (fgets(line, sizeof(line), file) != nullptr) {
+            if (line[0] == '#') {
+                continue;
+            }
+            Hashes hashes;
+            unsigned int number, indexed, paletteToLine, panel;
+            char rows[2 * BANDS + 1], columns[2 * BANDS + 1];
+            if (sscanf(line, "%u %x %x %x %32s %32s", &number, &indexed, &paletteToLine, &panel, rows, columns) != 6
+                    || !parseBands(rows, hashes.rows) || !parseBands(columns, hashes.columns)) {
+                fprintf(stderr, "%s: malformed line: %s", path, line);
+                mismatch = true;
+                break;
+            }
+            hashes.number = number;
+            hashes.indexed = indexed;
+            hashes.paletteToLine = paletteToLine;
+            hashes.panel = panel;
+            golden.push_back(hashes);
+        }
+        fclose(file);
+    }
+
+    void GoldenSink::write(const Frame& frame) {
+        const Hashes hashes = hashFrame(frame);
+        const size_t index = recorded.size();
+        recorded.push_back(hashes);
+
+        if (mode != Check || mismatch || index >= golden.size()) {
+            return;
+        }
+
+        /* A renderer without a framebuffer is only checked by what reaches the panel */
+        const Hashes& expected = golden[index];
+        if (expected.number != hashes.number || expected.panel != hashes.panel
+                || (hashes.indexed != 0 && (expected.indexed != hashes.indexed || expected.paletteToLine != hashes.paletteToLine))) {
+            report(expected, hashes);
+            mismatch = true;
+        }
+    }
+
+    void GoldenSink::report(const Hashes& expected, const Hashes& actual) {
+        fprintf(stderr, "%s: frame %u differs", path, (unsigned int)actual.number);
+        if (expected.panel == actual.panel) {
+            fprintf(stderr, ", the panel is identical but the %s\n",
+                    expected.indexed != actual.indexed ? "color indices are not" : "line palettes are not");
+            return;
+        }
+
+        int firstRow = -1, lastRow = -1, firstColumn = -1, lastColumn = -1;
+        for (int band = 0; band < BANDS; band++) {
+            if (expected.rows[band] != actual.rows[band]) {
+                lastRow = band;
+                firstRow = firstRow < 0 ? band : firstRow;
+            }
+            if (expected.columns[band] != actual.columns[band]) {
+                lastColumn = band;
+                firstColumn = firstColumn < 0 ? band : firstColumn;
+            }
+        }
+        /* Band hashes are short, a difference can go unnoticed in them */
+        if (firstRow < 0 || firstColumn < 0) {
+            fprintf(stderr, ", region unknown\n");
+            return;
+        }
+        const int bandHeight = PANEL_HEIGHT / BANDS;
+        const int bandWidth = PANEL_WIDTH / BANDS;
+        fprintf(stderr, " within x %d..%d, y %d..%d\n", firstColumn * bandWidth, (lastColumn + 1) * bandWidth - 1,
+                firstRow * bandHeight, (lastRow + 1) * bandHeight - 1);
+    }
+
+    bool GoldenSink::finish() {
+        if (mode == Record) {
+            FILE* file = fopen(path, "w");
+            if (file == nullptr) {
+                fprintf(stderr, "Cannot write %s\n", path);
+                return false;
+            }
+            fprintf(file, "# frame, framebuffer, paletteToLine, panel, panel rows, panel columns\n");
+            for (const Hashes& hashes : recorded) {
+                fprintf(file, "%u %08x %08x %08x ", (unsigned int)hashes.number, (unsigned int)hashes.indexed,
+                        (unsigned int)hashes.paletteToLine, (unsigned int)hashes.panel);
+                for (uint8_t band = 0; band < BANDS; band++) {
+                    fprintf(file, "%02x", hashes.rows[band]);
+                }
+                fputc(' ', file);
+                for (uint8_t band = 0; band < BANDS; band++) {
+                    fprintf(file, "%02x", hashes.columns[band]);
+                }
+                fputc('\n', file);
+            }
+            fclose(file);
+            return true;
+        }
+
+        if (!mismatch && recorded.size() != golden.size()) {
+            fprintf(stderr, "%s: %u frames, expected %u\n", path, (unsigned int)recorded.size(), (unsigned int)golden.size());
+            mismatch = true;
+        }
+        return !mismatch;
+    }
+
+}} // namespace spaceshoot::host
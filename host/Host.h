@@ -0,0 +1,172 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#ifndef SST_HOST_H
+#define SST_HOST_H
+
+#include "Gamebuino-Meta-ADTCRV.h"
+#include <stdint.h>
+#include <vector>
+
+/* Control of the host backend: where the frames go, the scripted buttons and when to stop */
+namespace spaceshoot { namespace host {
+
+    const uint16_t PANEL_WIDTH = 160;
+    const uint16_t PANEL_HEIGHT = 128;
+
+    /* A frame as it has been sent to the panel by update() */
+    struct Frame {
+        uint32_t number;
+        uint16_t width;                 /* Of the framebuffer, the panel is always PANEL_WIDTH x PANEL_HEIGHT */
+        uint16_t height;
+        const uint8_t* indexed;         /* The 4 bpp framebuffer, nullptr while there is none (strip renderer) or
+                                         * the display is rgb565 (low resolution renderer) */
+        const uint8_t* paletteToLine;   /* nullptr unless colorCells are enabled */
+        const uint16_t* rgb565;         /* The panel contents, native endianness */
+    };
+
+    class FrameSink {
+    public:
+        virtual ~FrameSink() {}
+        virtual void write(const Frame& frame) = 0;
+    };
+
+    /* Writes every nth frame into a directory, as NNNNNN.pgm with the color indices (0 to 15) and NNNNNN.ppm
+     * with the colors. Frames without a framebuffer only get the .ppm. */
+    class FileSink : public FrameSink {
+    public:
+        FileSink(const char* directory, uint32_t every = 1);
+        void write(const Frame& frame) override;
+
+    private:
+        const char* directory;
+        uint32_t every;
+    };
+
+    /* Writes the panel contents of every nth frame into a single file, as raw RGB24 video. Each frame has its own
+     * place in the file, so that workers of an ExportSink can write into it at the same time. To view it, at
+     * TARGET_FPS:
+     *     ffplay -f rawvideo -pixel_format rgb24 -video_size 160x128 -framerate 22 FILE */
+    class RawVideoSink : public FrameSink {
+    public:
+        static const size_t FRAME_BYTES = (size_t)PANEL_WIDTH * PANEL_HEIGHT * 3;
+
+        RawVideoSink(const char* path, uint32_t every = 1);
+        ~RawVideoSink();
+        void write(const Frame& frame) override;
+
+    private:
+        int fd;
+        uint32_t every;
+    };
+
+    /* Renders the frames in parallel. The process runs the game alone and, at every keyframe, forks a worker
+     * which goes on up to the next keyframe and hands its frames over to the output sink. The fork is an exact
+     * copy of the whole game state, so the workers need nothing else than the buttons already scripted. At most
+     * `jobs` workers run at a time. */
+    class ExportSink : public FrameSink {
+    public:
+        ExportSink(FrameSink& output, uint32_t keyframeInterval, unsigned int jobs);
+        void write(const Frame& frame) override;
+
+        /* Waits for all the workers, false if any of them has failed. Called in a worker, ends it. */
+        bool finish();
+
+    private:
+        FrameSink& output;
+        uint32_t keyframeInterval;
+        unsigned int jobs;
+        uint32_t nextKeyframe;
+        bool worker;
+        bool failed;
+        std::vector<int> workers;
+
+        void waitForWorker();
+    };
+
+    /* Keeps copies of the frames, the framebuffer being empty when there was none */
+    class MemorySink : public FrameSink {
+    public:
+        struct Stored {
+            uint32_t number;
+            std::vector<uint8_t> indexed;
+            std::vector<uint16_t> rgb565;
+        };
+
+        std::vector<Stored> frames;
+
+        void write(const Frame& frame) override;
+    };
+
+    /* Hashes of every frame: of the framebuffer, of the line to palette mapping and of the panel contents, the
+     * latter also per band of lines and of columns, to locate differences. Record writes them into a file,
+     * Check compares them against it and reports the first frame that differs. */
+    class GoldenSink : public FrameSink {
+    public:
+        enum Mode { Record, Check };
+
+        static const uint8_t BANDS = 16;
+
+        struct Hashes {
+            uint32_t number;
+            uint32_t indexed;           /* 0 when there is no framebuffer */
+            uint32_t paletteToLine;     /* 0 when colorCells are disabled */
+            uint32_t panel;
+            uint8_t rows[BANDS];        /* Bands of PANEL_HEIGHT / BANDS lines */
+            uint8_t columns[BANDS];     /* Bands of PANEL_WIDTH / BANDS columns */
+        };
+
+        GoldenSink(const char* path, Mode mode);
+        void write(const Frame& frame) override;
+
+        /* Writes the file (Record) or checks the number of frames (Check). False on any mismatch. */
+        bool finish();
+
+    private:
+        const char* path;
+        Mode mode;
+        std::vector<Hashes> golden;
+        std::vector<Hashes> recorded;
+        bool mismatch;
+
+        void report(const Hashes& expected, const Hashes& actual);
+    };
+
+    /* nullptr to drop the frames */
+    void setFrameSink(FrameSink* sink);
+
+    /* To the panel so far, by update() and by Tft::sendBuffer() */
+    uint64_t bytesSent();
+
+    /* Holds the button down from frame `first` for `frames` frames */
+    void holdButton(Button button, uint32_t first, uint16_t frames = 1);
+
+    /* From now on micros() advances by frameMicros in update() only, so the timings shown and the decisions
+     * taken from them are the same in every run */
+    void useVirtualClock(uint32_t frameMicros);
+
+    /* The process ends after that many frames (0: never), atExit is called first */
+    void setFrameLimit(uint32_t frames, void (*atExit)() = nullptr);
+
+}} // namespace spaceshoot::host
+
+#endif // SST_HOST_H
@@ -0,0 +1,318 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+// Runs the game, or one of its contexts, on the host: without a display, as fast as it goes, with scripted
+// buttons and the frames written to files. From the repository root:
+//
+//     g++ -std=gnu++11 -O2 -Ihost -Isrc host/*.cpp src/*.cpp -o spaceshoot-host
+//     ./spaceshoot-host --context game --frames 2000 --out frames --every 10 --press a@0+2000
+//     ./spaceshoot-host --context microbench --results microbench.csv
+//     ./spaceshoot-host --context rastertest
+//     ./spaceshoot-host --context game --frames 1320 --session session.txt --raw game.rgb --jobs 8
+//
+// scripts/golden.sh runs every context against the hashes in host/golden. The tables shared with the C++ sources
+// are C++ headers: the Arduino build compiles the .c files in src as C, and golden.sh checks that they still do.
+//
+// The host directory has to come first on the include path, its headers stand in for the library.
+
+#include "Gamebuino-Meta-ADTCRV.h"
+#include "Host.h"
+#include "Configuration.h"
+#include "SpaceShoot.h"
+#include "GameContext.h"
+#include "GameOverContext.h"
+#include "MainMenuContext.h"
+#include "TitleScreenContext.h"
+#include "InstructionsContext.h"
+#include "BenchmarkContext.h"
+#include "Microbench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+namespace spaceshoot {
+    /* Defined with the rest of the game state in SpaceShoot.cpp */
+    extern context::game::Context ctx;
+}
+
+using namespace spaceshoot;
+
+static const char* const BUTTON_NAMES[NUM_BUTTONS] = { "down", "left", "right", "up", "a", "b", "menu", "home" };
+
+static std::chrono::steady_clock::time_point startTime;
+static const char* resultsPath = "microbench.csv";
+static host::GoldenSink* goldenSink;
+static host::ExportSink* exportSink;
+
+static const char* const RENDERER_NAMES[] = { "incremental", "scanline", "strips", "lowres" };
+static_assert(sizeof(RENDERER_NAMES) / sizeof(RENDERER_NAMES[0]) == (size_t)context::game::RenderMode::Count);
+
+static void usage() {
+    fprintf(stderr,
+            "Usage: spaceshoot-host [options]\n"
+            "  --context NAME    all (default), titlescreen, mainmenu, game, gameover, instructions, benchmark,\n"
+            "                    microbench, rastertest (exits with an error if a check fails)\n"
+            "  --frames N        stop after N frames (default 1000, 0: never)\n"
+            "  --out DIR         write the frames into DIR (an existing directory)\n"
+            "  --raw FILE        write the frames into FILE as raw RGB24 video instead\n"
+            "  --every N         write only every Nth frame\n"
+            "  --jobs N          write the frames with N processes in parallel (default 1)\n"
+            "  --keyframe N      frames per process when writing in parallel (default 220)\n"
+            "  --press B@F[+N]   hold button B (down, left, right, up, a, b, menu, home) from frame F for N frames\n"
+            "  --session FILE    hold the buttons listed in FILE, one B@F[+N] per line, # for comments\n"
+            "  --results FILE    microbenchmark results, as CSV (default microbench.csv)\n"
+            "  --flags N         game flags, as a number (see FLAG_* in GameContext.h)\n"
+            "  --renderer NAME   incremental (default), scanline, strips, lowres\n"
+            "  --golden FILE     check the frames against the hashes in FILE, on a virtual clock\n"
+            "  --record          write the hashes into the --golden file instead\n"
+            "Frames written with --out or --raw, like the checked ones, are timed by a virtual clock.\n");
+    exit(1);
+}
+
+static void printSummary() {
+    if (exportSink != nullptr && !exportSink->finish()) {
+        fprintf(stderr, "Some of the frames have not been written\n");
+        exit(1);
+    }
+    const uint32_t elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - startTime).count();
+    if (goldenSink != nullptr) {
+        const bool passed = goldenSink->finish();
+        printf("%u frames, golden %s\n", (unsigned int)gb.frameCount, passed ? "OK" : "FAILED");
+        if (!passed) {
+            exit(1);
+        }
+        return;
+    }
+    printf("%u frames in %u ms, %u us per frame\n", (unsigned int)gb.frameCount, (unsigned int)(elapsed / 1000),
+            (unsigned int)(gb.frameCount > 0 ? elapsed / gb.frameCount : 0));
+    printf("%llu bytes sent to the panel, %llu per frame\n", (unsigned long long)host::bytesSent(),
+            (unsigned long long)(gb.frameCount > 0 ? host::bytesSent() / gb.frameCount : 0));
+    if (elapsed > 0) {
+        printf("%.1f times faster than real time\n", (double)gb.frameCount * 1000000 / TARGET_FPS / elapsed);
+    }
+}
+
+static bool parsePress(const char* arg) {
+    char name[16];
+    unsigned int first;
+    unsigned int frames = 1;
+    if (sscanf(arg, "%15[a-z]@%u+%u", name, &first, &frames) < 2) {
+        return false;
+    }
+    for (uint8_t ix = 0; ix < NUM_BUTTONS; ix++) {
+        if (strcmp(name, BUTTON_NAMES[ix]) == 0) {
+            host::holdButton((Button)ix, first, frames);
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool readSession(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (file == nullptr) {
+        perror(path);
+        return false;
+    }
+    char line[64];
+    bool valid = true;
+    while (valid && fgets(line, sizeof(line), file) != nullptr) {
+        char press[32];
+        if (sscanf(line, " %31s", press) == 1 && press[0] != '#') {
+            valid = parsePress(press);
+        }
+    }
+    fclose(file);
+    return valid;
+}
+
+static bool parseRenderer(const char* arg) {
+    for (uint8_t ix = 0; ix < (uint8_t)context::game::RenderMode::Count; ix++) {
+        if (strcmp(arg, RENDERER_NAMES[ix]) == 0) {
+            ctx.renderMode = (context::game::RenderMode)ix;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void runMicrobench() {
+    microbench::Result results[microbench::MAX_RESULTS];
+    const size_t count = microbench::run(ctx, results);
+
+    FILE* file = fopen(resultsPath, "w");
+    if (file == nullptr) {
+        perror(resultsPath);
+        exit(1);
+    }
+    fprintf(file, "%s\n", microbench::CSV_HEADER);
+    printf("%s\n", microbench::CSV_HEADER);
+    for (size_t ix = 0; ix < count; ix++) {
+        char line[96];
+        microbench::formatCsv(line, sizeof(line), results[ix]);
+        fprintf(file, "%s\n", line);
+        printf("%s\n", line);
+    }
+    fclose(file);
+}
+
+static void runRasterTest() {
+    context::benchmark::RasterCheck checks[context::benchmark::NUM_RASTER_CHECKS];
+    context::benchmark::checkRaster(checks);
+
+    bool passed = true;
+    for (size_t ix = 0; ix < context::benchmark::NUM_RASTER_CHECKS; ix++) {
+        printf("%-12s %s\n", checks[ix].name, checks[ix].exact ? "OK" : "FAILED");
+        passed = passed && checks[ix].exact;
+    }
+    exit(passed ? 0 : 1);
+}
+
+static void runContext(const char* name) {
+    if (strcmp(name, "all") == 0) {
+        while (1) {
+            spaceshoot::main();
+        }
+    } else if (strcmp(name, "titlescreen") == 0) {
+        context::titlescreen::run();
+    } else if (strcmp(name, "mainmenu") == 0) {
+        context::mainmenu::run(ctx);
+    } else if (strcmp(name, "game") == 0) {
+        context::game::restart(ctx);
+        context::game::run(ctx);
+    } else if (strcmp(name, "gameover") == 0) {
+        context::game::restart(ctx);
+        ctx.score = 1234;
+        ctx.shoots = 200;
+        ctx.hits = 150;
+        ctx.numBombs = 2;
+        context::gameover::run(ctx, true);
+    } else if (strcmp(name, "instructions") == 0) {
+        context::instructions::run();
+    } else if (strcmp(name, "benchmark") == 0) {
+        context::benchmark::run(ctx);
+    } else if (strcmp(name, "microbench") == 0) {
+        runMicrobench();
+    } else if (strcmp(name, "rastertest") == 0) {
+        runRasterTest();
+    } else {
+        usage();
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* contextName = "all";
+    const char* outDir = nullptr;
+    const char* rawPath = nullptr;
+    const char* goldenPath = nullptr;
+    bool record = false;
+    int flags = -1;
+    const char* renderer = RENDERER_NAMES[0];
+    uint32_t frames = 1000;
+    uint32_t every = 1;
+    unsigned int jobs = 1;
+    uint32_t keyframeInterval = TARGET_FPS * 10;
+
+    for (int ix = 1; ix < argc; ix++) {
+        const bool hasValue = ix + 1 < argc;
+        if (strcmp(argv[ix], "--context") == 0 && hasValue) {
+            contextName = argv[++ix];
+        } else if (strcmp(argv[ix], "--frames") == 0 && hasValue) {
+            frames = strtoul(argv[++ix], nullptr, 10);
+        } else if (strcmp(argv[ix], "--out") == 0 && hasValue) {
+            outDir = argv[++ix];
+        } else if (strcmp(argv[ix], "--raw") == 0 && hasValue) {
+            rawPath = argv[++ix];
+        } else if (strcmp(argv[ix], "--every") == 0 && hasValue) {
+            every = strtoul(argv[++ix], nullptr, 10);
+        } else if (strcmp(argv[ix], "--jobs") == 0 && hasValue) {
+            jobs = strtoul(argv[++ix], nullptr, 10);
+        } else if (strcmp(argv[ix], "--keyframe") == 0 && hasValue) {
+            keyframeInterval = strtoul(argv[++ix], nullptr, 10);
+        } else if (strcmp(argv[ix], "--results") == 0 && hasValue) {
+            resultsPath = argv[++ix];
+        } else if (strcmp(argv[ix], "--flags") == 0 && hasValue) {
+            flags = strtoul(argv[++ix], nullptr, 0);
+        } else if (strcmp(argv[ix], "--renderer") == 0 && hasValue) {
+            renderer = argv[++ix];
+        } else if (strcmp(argv[ix], "--golden") == 0 && hasValue) {
+            goldenPath = argv[++ix];
+        } else if (strcmp(argv[ix], "--record") == 0) {
+            record = true;
+        } else if (strcmp(argv[ix], "--press") == 0 && hasValue) {
+            if (!parsePress(argv[++ix])) {
+                usage();
+            }
+        } else if (strcmp(argv[ix], "--session") == 0 && hasValue) {
+            if (!readSession(argv[++ix])) {
+                usage();
+            }
+        } else {
+            usage();
+        }
+    }
+
+    host::FileSink fileSink(outDir != nullptr ? outDir : ".", every);
+    host::RawVideoSink rawSink(rawPath != nullptr ? rawPath : "/dev/null", every);
+    host::FrameSink* output = rawPath != nullptr ? (host::FrameSink*)&rawSink : outDir != nullptr ? &fileSink : nullptr;
+    host::ExportSink parallel(output != nullptr ? *output : fileSink, keyframeInterval, jobs);
+    /* Only reads the golden file when there is one to check against */
+    host::GoldenSink golden(goldenPath != nullptr ? goldenPath : "",
+            record || goldenPath == nullptr ? host::GoldenSink::Record : host::GoldenSink::Check);
+    if (goldenPath != nullptr) {
+        /* Frames are not written into files at the same time */
+        goldenSink = &golden;
+        host::setFrameSink(&golden);
+        host::useVirtualClock(1000000 / TARGET_FPS);
+    } else if (output != nullptr) {
+        /* The picture depends on the timings only with the profiling info shown, but then it is the same in every
+         * run and with any number of jobs */
+        if (jobs > 1) {
+            exportSink = &parallel;
+        }
+        host::setFrameSink(jobs > 1 ? (host::FrameSink*)&parallel : output);
+        host::useVirtualClock(1000000 / TARGET_FPS);
+    } else {
+        host::setFrameSink(nullptr);
+    }
+    host::setFrameLimit(frames, printSummary);
+    srand(context::benchmark::RANDOM_SEED);
+
+    /* As in the sketch's setup() */
+    spaceshoot::init();
+    if (flags >= 0) {
+        ctx.flags = flags;
+    }
+    if (!parseRenderer(renderer)) {
+        usage();
+    }
+    gb.begin();
+    gb.display.init(SCREEN_WIDTH, SCREEN_HEIGHT, SCREEN_MODE);
+    gb.setFrameRate(TARGET_FPS);
+
+    startTime = std::chrono::steady_clock::now();
+    runContext(contextName);
+    printSummary();
+    return 0;
+}
@@ -0,0 +1,66 @@
+#!/bin/sh
+
+# Runs every context on the host with scripted buttons and checks each frame against the hashes in host/golden.
+# The game runs with every combination of flags and with every renderer, all of them against the same hashes, except
+# for the low resolution one. The raster primitives are checked against gb.display as well, and the C sources in src
+# have to compile as C.
+#
+#     scripts/golden.sh [path to spaceshoot-host]             checks
+#     RECORD=1 scripts/golden.sh [path to spaceshoot-host]    writes the hashes anew (incremental renderer only)
+
+HOST=${1:-./spaceshoot-host}
+GOLDEN=$(dirname "$0")/../host/golden
+SRC=$(dirname "$0")/../src
+FAILED=0
+
+run() {
+    name=$1
+    shift
+    if [ -n "$RECORD" ]; then
+        "$HOST" --golden "$GOLDEN/$name.txt" --record "$@" > /dev/null || FAILED=1
+    else
+        echo "$name $*"
+        "$HOST" --golden "$GOLDEN/$name.txt" "$@" || FAILED=1
+    fi
+}
+
+mkdir -p "$GOLDEN"
+
+# The host runner is built from the C++ sources only, but the Arduino build compiles the .c files in src as C
+for source in "$SRC"/*.c; do
+    [ -e "$source" ] || continue
+    echo "$source"
+    ${CC:-cc} -std=gnu11 -fsyntax-only -I"$SRC" "$source" || FAILED=1
+done
+
+# The raster primitives against gb.display, pixel for pixel, with nothing to record
+if [ -z "$RECORD" ]; then
+    echo "rastertest"
+    "$HOST" --context rastertest || FAILED=1
+fi
+
+run titlescreen --context titlescreen --frames 200
+run mainmenu --context mainmenu --frames 180 \
+    --press down@30 --press down@40 --press a@50 --press down@70 --press right@80 --press down@90 \
+    --press left@100 --press down@110 --press right@120 --press b@140 --press up@160
+run instructions --context instructions --frames 160 \
+    --press down@30 --press down@60 --press down@90 --press down@120
+run gameover --context gameover --frames 180
+
+for flags in 0 1 2 3 4 5 6 7; do
+    for renderer in incremental scanline strips; do
+        if [ -n "$RECORD" ] && [ $renderer != incremental ]; then
+            continue
+        fi
+        run game-flags$flags --context game --flags $flags --renderer $renderer --frames 240 \
+            --press a@20+100 --press down@40 --press down@60 --press up@90 --press b@120 --press down@150+30
+    done
+done
+
+# The low resolution profile draws a picture of its own
+for flags in 0 1 2 3 4 5 6 7; do
+    run game-lowres-flags$flags --context game --flags $flags --renderer lowres --frames 240 \
+        --press a@20+100 --press down@40 --press down@60 --press up@90 --press b@120 --press down@150+30
+done
+
+exit $FAILED
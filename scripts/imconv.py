@@ -54,6 +54,55 @@ def bmp_4bit_indexed_to_c(img: Image, params: list):
 
     return palette_str + "\n" + pixels_str
 
+def bmp_4bit_indexed_to_atlas(img: Image, params: list):
+    if len(params) < 4:
+        print("Tile atlas requires 4 or 5 parameters: ")
+        print(" - Array name")
+        print(" - Tile width (even) and height")
+        print(" - X of the first tile")
+        print(" - Number of tiles (optional, as many as fit by default)")
+        return None
+
+    name = params[0]
+    tile_width = int(params[1])
+    tile_height = int(params[2])
+    first_x = int(params[3])
+    if len(params) > 4:
+        count = int(params[4])
+    else:
+        count = (img.width - first_x) // tile_width
+
+    assert(tile_width % 2 == 0)
+    assert(first_x + count * tile_width <= img.width)
+    assert(tile_height <= img.height)
+
+    # Each tile is stored whole, shifted by 0 and by 1 pixel, so that it can be blitted into a 4 bpp framebuffer
+    # at any x with byte operations. A row holds the pixels padded to whole bytes, then the bits of the
+    # framebuffer to keep (color 0 is transparent).
+    row_bytes = tile_width // 2 + 1
+    atlas_str = "const uint8_t %sAtlas[%d][2][%d][%d] = {" % (name, count, tile_height, row_bytes * 2)
+
+    for tile in range(0, count):
+        atlas_str += "\n    /* %d */ {" % tile
+        for shift in range(0, 2):
+            atlas_str += "\n        {"
+            for y in range(0, tile_height):
+                pixels = [0] * shift
+                for x in range(0, tile_width):
+                    pixels.append(img.getpixel( (first_x + tile * tile_width + x, y) ))
+                pixels += [0] * (row_bytes * 2 - len(pixels))
+
+                data = [pixels[ix] << 4 | pixels[ix + 1] for ix in range(0, len(pixels), 2)]
+                keep = [(0xf0 if pixels[ix] == 0 else 0) | (0x0f if pixels[ix + 1] == 0 else 0)
+                        for ix in range(0, len(pixels), 2)]
+                atlas_str += "\n            {" + ", ".join("0x%02x" % byte for byte in data + keep) + "},"
+            atlas_str = atlas_str[:-1] + "\n        },"
+        atlas_str = atlas_str[:-1] + "\n    },"
+
+    atlas_str = atlas_str[:-1] + "\n};"
+
+    return atlas_str
+
 def gbm_screenshot_palette_fixup(img: Image, params: list):
     if len(params) < 1:
         print("Gamebuino Meta screenshot palette fixup requires 2 or 3 parameters: ")
@@ -129,6 +178,9 @@ if __name__ == "__main__":
         "bmp4-c": (
             "indexed 16-color (4 bpp) BMP to C code",
             bmp_4bit_indexed_to_c),
+        "bmp4-atlas": (
+            "indexed 16-color (4 bpp) BMP of tiles to a C tile atlas",
+            bmp_4bit_indexed_to_atlas),
         "gbmss-colorcells1-deploy": (
             "Palette fixup for Gamebuino Meta screenshot (or recording)",
             gbm_screenshot_palette_fixup)
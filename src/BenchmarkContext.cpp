@@ -0,0 +1,418 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#include "BenchmarkContext.h"
+#include "GameContext.h"
+#include "Microbench.h"
+#include "Particles.h"
+#include "Starfield.h"
+#include "Raster.h"
+#include "Text.h"
+#include "Configuration.h"
+#include "Utils.h"
+#include "Gamebuino-Meta-ADTCRV.h"
+#include "Font3x5.h"
+#include "Font4x7.h"
+
+namespace spaceshoot { namespace context { namespace benchmark {
+
+using ElementID = tileset::ElementID;
+
+    struct Scenario {
+        const char* name;
+        uint8_t flags;
+        uint8_t density;        /* Probability of a cell being occupied, in 1/24 */
+        bool fireAllRows;
+        bool salvo;
+        bool particles;
+    };
+
+    const uint8_t ALL_FLAGS = game::FLAG_SMOOTH_SCROLLING | game::FLAG_SHOW_BACKGROUND | game::FLAG_SHOW_PROFILING_INFO;
+
+    static const Scenario SCENARIOS[] = {
+        {"Empty field",       0,          0,  false, false, false},
+        {"Empty, all on",     ALL_FLAGS,  0,  false, false, false},
+        {"Full density",      ALL_FLAGS,  24, false, false, false},
+        {"All rows firing",   ALL_FLAGS,  18, true,  false, false},
+        {"Salvo",             ALL_FLAGS,  24, false, true,  false},
+        {"Worst case",        ALL_FLAGS,  24, true,  true,  true},
+    };
+    const size_t NUM_SCENARIOS = sizeof(SCENARIOS) / sizeof(SCENARIOS[0]);
+
+    const uint16_t WARMUP_FRAMES = 8;
+    const uint16_t MEASURED_FRAMES = 128;
+
+    struct Result {
+        uint16_t min;
+        uint16_t avg;
+        uint16_t p99;
+    };
+
+    static const Scenario* activeScenario;
+    static uint16_t frameIndex;
+    static uint16_t samples[MEASURED_FRAMES];
+
+    void fillField(game::Context& ctx, uint8_t density, bool onlyEmpty) {
+        for (size_t row = 0; row < NUM_ROWS; row++) {
+            /* Keep the first column clear, otherwise the first scroll step ends the game */
+            game::setBlockClearMissile(ctx, row, 0, ElementID::None);
+
+            for (size_t col = 1; col < NUM_COLS; col++) {
+                if (onlyEmpty && game::getBlock(ctx, row, col) != ElementID::None) {
+                    continue;
+                }
+                int randval = rand();
+                if (randval % 24 < density) {
+                    uint8_t b = (uint8_t)ElementID::Debris1 + (randval & 0x07);
+                    game::setBlock(ctx, row, col, static_cast<ElementID>(b));
+                }
+            }
+        }
+    }
+
+    static bool scenarioFrame(game::Context& ctx) {
+        const Scenario& scenario = *activeScenario;
+
+        if (frameIndex == 0) {
+            fillField(ctx, scenario.density, false);
+        } else {
+            fillField(ctx, scenario.density, true);
+        }
+
+        if (scenario.fireAllRows) {
+            for (size_t row = 0; row < NUM_ROWS; row++) {
+                game::setMissile(ctx, row, 0, true);
+            }
+            ctx.shoots += NUM_ROWS;
+        }
+
+        if (scenario.salvo) {
+            ctx.numBombs = 99;
+            ctx.salvoCounter = 4;
+        }
+
+        if (scenario.particles) {
+            particles::saturate();
+        }
+
+        /* gb.frameDurationMicros refers to the previous frame, which is the first one to be measured after warm-up */
+        if (frameIndex > WARMUP_FRAMES) {
+            uint32_t duration = gb.frameDurationMicros;
+            samples[frameIndex - WARMUP_FRAMES - 1] = duration > 0xFFFF ? 0xFFFF : duration;
+        }
+
+        frameIndex++;
+        return frameIndex <= WARMUP_FRAMES + MEASURED_FRAMES;
+    }
+
+    static Result computeResult() {
+        /* Insertion sort, the sample count is small */
+        for (size_t ix = 1; ix < MEASURED_FRAMES; ix++) {
+            uint16_t v = samples[ix];
+            size_t jx = ix;
+            while (jx > 0 && samples[jx - 1] > v) {
+                samples[jx] = samples[jx - 1];
+                jx--;
+            }
+            samples[jx] = v;
+        }
+
+        uint32_t sum = 0;
+        for (size_t ix = 0; ix < MEASURED_FRAMES; ix++) {
+            sum += samples[ix];
+        }
+
+        Result result;
+        result.min = samples[0];
+        result.avg = sum / MEASURED_FRAMES;
+        result.p99 = samples[(MEASURED_FRAMES * 99) / 100];
+        return result;
+    }
+
+    /* Raster primitives and text output vs. their gb.display counterparts: both draw the same pseudo-random
+     * shapes, including odd coordinates and clipped ones, and the resulting framebuffers have to be identical */
+    enum struct RasterTest : uint8_t {
+        FillRect,
+        VLine,
+        Pixels,
+        Text,
+        Count
+    };
+
+    static const char* const RASTER_TEST_NAMES[] = {"fillRect", "drawVLine", "drawPixels", "text::print"};
+    const size_t RASTER_SHAPES = 64;
+
+    struct RasterResult {
+        uint32_t referenceMicros;
+        uint32_t rasterMicros;
+        bool exact;
+    };
+
+    static uint32_t hashFramebuffer() {
+        return hashFnv1a(FNV_OFFSET, raster::framebuffer(), raster::LINE_BYTES * SCREEN_HEIGHT);
+    }
+
+    static uint32_t drawShapes(RasterTest test, bool useRaster) {
+        uint8_t* buffer = raster::framebuffer();
+        raster::Pixel pixels[RASTER_SHAPES];
+
+        srand(RANDOM_SEED);
+        memset(buffer, 0, raster::LINE_BYTES * SCREEN_HEIGHT);
+
+        uint32_t start = micros();
+        for (size_t ix = 0; ix < RASTER_SHAPES; ix++) {
+            int16_t x = rand() % (SCREEN_WIDTH + 16) - 8;
+            int16_t y = rand() % (SCREEN_HEIGHT + 16) - 8;
+            int16_t w = rand() % 64 + 1;
+            int16_t h = rand() % 32 + 1;
+            uint8_t color = rand() & 0x0F;
+            char str[8];
+            for (size_t cx = 0; cx < sizeof(str) - 1; cx++) {
+                str[cx] = ' ' + rand() % 95;
+            }
+            str[sizeof(str) - 1] = '\0';
+
+            switch (test) {
+                case RasterTest::FillRect:
+                    if (useRaster) {
+                        raster::fillRect(buffer, x, y, w, h, color);
+                    } else {
+                        gb.display.setColor((ColorIndex)color);
+                        gb.display.fillRect(x, y, w, h);
+                    }
+                    break;
+                case RasterTest::VLine:
+                    if (useRaster) {
+                        raster::drawVLine(buffer, x, y, h, color);
+                    } else {
+                        gb.display.setColor((ColorIndex)color);
+                        gb.display.drawFastVLine(x, y, h);
+                    }
+                    break;
+                case RasterTest::Text:
+                    if (useRaster) {
+                        text::setFormat((ColorIndex)color, 1 + (w & 0x01), 1 + (h & 0x01), (ix & 0x01) ? text::FONT_3X5 : text::FONT_4X7);
+                        text::print(x, y, str);
+                    } else {
+                        setTextFormat((ColorIndex)color, 1 + (w & 0x01), 1 + (h & 0x01), (ix & 0x01) ? font3x5 : font4x7);
+                        gb.display.print(x, y, str);
+                    }
+                    break;
+                default:
+                    if (useRaster) {
+                        pixels[ix] = {x, y, color};
+                    } else {
+                        gb.display.setColor((ColorIndex)color);
+                        gb.display.drawPixel(x, y);
+                    }
+                    break;
+            }
+        }
+        if (test == RasterTest::Pixels && useRaster) {
+            raster::drawPixels(buffer, pixels, RASTER_SHAPES);
+        }
+        return micros() - start;
+    }
+
+    static void runRasterTests(RasterResult results[]) {
+        for (size_t ix = 0; ix < (size_t)RasterTest::Count; ix++) {
+            RasterTest test = static_cast<RasterTest>(ix);
+            results[ix].referenceMicros = drawShapes(test, false);
+            uint32_t referenceHash = hashFramebuffer();
+            results[ix].rasterMicros = drawShapes(test, true);
+            results[ix].exact = hashFramebuffer() == referenceHash;
+        }
+    }
+
+    /* Masked copy has no gb.display counterpart, so it is checked against the plain byte by byte formula */
+    static bool checkMaskedCopy() {
+        uint8_t src[raster::LINE_BYTES];
+        uint8_t keep[raster::LINE_BYTES];
+        uint8_t expected[raster::LINE_BYTES];
+        uint8_t* line = raster::framebuffer();
+
+        srand(RANDOM_SEED);
+        for (size_t ix = 0; ix < raster::LINE_BYTES; ix++) {
+            line[ix] = rand();
+            keep[ix] = (rand() & 0x01) ? 0x0F : 0xF0;
+            src[ix] = rand() & ~keep[ix];
+        }
+
+        /* Odd offsets and lengths exercise the unaligned head and the tail */
+        for (size_t offset = 0; offset < 4; offset++) {
+            size_t bytes = raster::LINE_BYTES - offset * 3;
+            for (size_t ix = 0; ix < bytes; ix++) {
+                expected[ix] = (line[offset + ix] & keep[ix]) | src[ix];
+            }
+            raster::maskedCopy(line + offset, src, keep, bytes);
+            if (memcmp(line + offset, expected, bytes) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static_assert(NUM_RASTER_CHECKS == (size_t)RasterTest::Count + 1);
+
+    void checkRaster(RasterCheck checks[NUM_RASTER_CHECKS]) {
+        RasterResult results[(size_t)RasterTest::Count];
+        runRasterTests(results);
+        for (size_t ix = 0; ix < (size_t)RasterTest::Count; ix++) {
+            checks[ix] = {RASTER_TEST_NAMES[ix], results[ix].exact};
+        }
+        checks[(size_t)RasterTest::Count] = {"maskedCopy", checkMaskedCopy()};
+    }
+
+    static void printMillis(uint8_t x, uint8_t y, uint16_t duration) {
+        gb.display.printf(x, y, "%2d.%d", duration / 1000, (duration / 100) % 10);
+    }
+
+    static void drawReport(const Result results[], uint32_t particlesMicros, uint32_t starfieldMicros,
+                           const RasterResult rasterResults[], bool maskedCopyExact) {
+        gb.tft.colorCells.enabled = false;
+        gb.tft.setPalette(Gamebuino_Meta::defaultColorPalette);
+        gb.lights.clear();
+        gb.display.clear();
+
+        setTextFormat(INDEX_YELLOW, 1, 1, font4x7);
+        gb.display.print(0, 0, "BENCHMARK");
+        gb.display.setColor(INDEX_GRAY);
+        gb.display.print(0, 8, "Frame time [ms]");
+
+        setTextFormat(INDEX_LIGHTBLUE, 1, 1, font3x5);
+        gb.display.print(80, 20, "MIN");
+        gb.display.print(104, 20, "AVG");
+        gb.display.print(128, 20, "P99");
+
+        uint8_t y = 30;
+        for (size_t ix = 0; ix < NUM_SCENARIOS; ix++) {
+            gb.display.setColor(INDEX_WHITE);
+            gb.display.print(0, y, SCENARIOS[ix].name);
+            gb.display.setColor(INDEX_LIGHTGREEN);
+            printMillis(80, y, results[ix].min);
+            printMillis(104, y, results[ix].avg);
+            gb.display.setColor(INDEX_ORANGE);
+            printMillis(128, y, results[ix].p99);
+            y += 8;
+        }
+
+        gb.display.setColor(INDEX_WHITE);
+        gb.display.printf(0, y + 4, "Particles (%d): %d us, stars (%d): %d us", (int)particles::POOL_SIZE, particlesMicros,
+                          (int)starfield::count(), starfieldMicros);
+
+        y += 10;
+        for (size_t ix = 0; ix < (size_t)RasterTest::Count; ix++) {
+            gb.display.setColor(INDEX_WHITE);
+            gb.display.printf(0, y, "%s: %d us vs %d us", RASTER_TEST_NAMES[ix],
+                              (int)rasterResults[ix].rasterMicros, (int)rasterResults[ix].referenceMicros);
+            gb.display.setColor(rasterResults[ix].exact ? INDEX_LIGHTGREEN : INDEX_RED);
+            gb.display.print(136, y, rasterResults[ix].exact ? "OK" : "FAIL");
+            y += 6;
+        }
+        gb.display.setColor(INDEX_WHITE);
+        gb.display.print(0, y, "maskedCopy:");
+        gb.display.setColor(maskedCopyExact ? INDEX_LIGHTGREEN : INDEX_RED);
+        gb.display.print(136, y, maskedCopyExact ? "OK" : "FAIL");
+
+        setTextFormat(INDEX_WHITE, 1, 1, font4x7);
+        gb.display.print(0, 120, "\x01\x08:calls  \x02\x09:return to menu");
+    }
+
+    static void drawMicrobenchReport(const microbench::Result results[], size_t count) {
+        gb.tft.colorCells.enabled = false;
+        gb.tft.setPalette(Gamebuino_Meta::defaultColorPalette);
+        gb.display.clear();
+
+        setTextFormat(INDEX_YELLOW, 1, 1, font4x7);
+        gb.display.print(0, 0, "MICROBENCHMARKS");
+        gb.display.setColor(INDEX_GRAY);
+        gb.display.print(0, 8, "Time per call");
+
+        setTextFormat(INDEX_LIGHTBLUE, 1, 1, font3x5);
+        gb.display.print(108, 20, "US");
+        gb.display.print(132, 20, "CYCLES");
+
+        uint8_t y = 28;
+        for (size_t ix = 0; ix < count; ix++) {
+            const uint32_t nanos = microbench::nanosPerIteration(results[ix]);
+            gb.display.setColor(INDEX_WHITE);
+            gb.display.print(0, y, results[ix].name);
+            gb.display.setColor(INDEX_LIGHTGREEN);
+            gb.display.printf(96, y, "%5d.%d", (int)(nanos / 1000), (int)((nanos / 100) % 10));
+#ifdef F_CPU
+            gb.display.setColor(INDEX_ORANGE);
+            gb.display.printf(128, y, "%7d", (int)((uint64_t)nanos * (F_CPU / 1000000) / 1000));
+#endif
+            y += 6;
+        }
+
+        setTextFormat(INDEX_WHITE, 1, 1, font4x7);
+        gb.display.print(0, 120, "\x02\x09:return to menu");
+    }
+
+    void run(game::Context& ctx) {
+        Result results[NUM_SCENARIOS];
+
+        uint8_t savedDifficultyLevel = ctx.difficultyLevel;
+        uint8_t savedFlags = ctx.flags;
+
+        for (size_t ix = 0; ix < NUM_SCENARIOS; ix++) {
+            activeScenario = &SCENARIOS[ix];
+            frameIndex = 0;
+
+            srand(RANDOM_SEED);
+            game::restart(ctx);
+            ctx.difficultyLevel = 5;
+            ctx.flags = activeScenario->flags;
+            game::run(ctx, scenarioFrame);
+
+            results[ix] = computeResult();
+        }
+
+        ctx.difficultyLevel = savedDifficultyLevel;
+        ctx.flags = savedFlags;
+        game::restart(ctx);
+
+        uint32_t particlesMicros = particles::benchmarkFullPool(16);
+        uint32_t starfieldMicros = starfield::benchmarkDraw(16);
+
+        RasterResult rasterResults[(size_t)RasterTest::Count];
+        runRasterTests(rasterResults);
+        bool maskedCopyExact = checkMaskedCopy();
+
+        drawReport(results, particlesMicros, starfieldMicros, rasterResults, maskedCopyExact);
+
+        while (1) {
+            processEvents();
+            if (gb.buttons.pressed(BUTTON_A)) {
+                microbench::Result microbenchResults[microbench::MAX_RESULTS];
+                size_t count = microbench::run(ctx, microbenchResults);
+                drawMicrobenchReport(microbenchResults, count);
+            }
+            if (gb.buttons.pressed(BUTTON_B)) {
+                gb.display.clear();
+                return;
+            }
+        }
+    }
+
+}}} // namespace spaceshoot::context::benchmark
@@ -0,0 +1,49 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#ifndef SST_BENCHMARKCONTEXT_H
+#define SST_BENCHMARKCONTEXT_H
+
+#include "GameContext.h"
+
+namespace spaceshoot { namespace context { namespace benchmark {
+
+    /* Every benchmark and microbenchmark starts from it, so the runs can be compared */
+    const unsigned int RANDOM_SEED = 0x5EED;
+
+    /* Debris in every column but the first one, each cell occupied with a probability of density / 24 */
+    void fillField(game::Context& ctx, uint8_t density, bool onlyEmpty);
+
+    struct RasterCheck {
+        const char* name;
+        bool exact;
+    };
+
+    /* The raster primitives and text output vs. gb.display, and masked copy vs. its plain formula */
+    const size_t NUM_RASTER_CHECKS = 5;
+
+    void checkRaster(RasterCheck checks[NUM_RASTER_CHECKS]);
+    void run(game::Context& ctx);
+
+}}} // namespace spaceshoot::context::benchmark
+
+#endif // SST_BENCHMARKCONTEXT_H
@@ -29,31 +29,35 @@ const size_t NUM_ROWS=20;
 const size_t NUM_COLS=39;
 const unsigned int TARGET_FPS = 22;
 
-#define HIGH_RESOLUTION_MODE
 //#define STORY_IMPLEMENTED
 //#define HIGHSCORES_IMPLEMENTED
 
-#ifdef HIGH_RESOLUTION_MODE
-    const size_t SCREEN_WIDTH = 160;
-    const size_t SCREEN_HEIGHT = 128;
-    const ColorMode SCREEN_MODE = ColorMode::index;
-
-    const size_t BLOCK_WIDTH = 4;
-    const size_t BLOCK_HEIGHT = 5;
-    const size_t PLAYER_WIDTH = 8;
-    const size_t PLAYER_HEIGHT = 5;
-    const size_t GAMEBOARD_Y = 16;
-#else
-    const size_t SCREEN_WIDTH = 80;
-    const size_t SCREEN_HEIGHT = 64;
-    const ColorMode SCREEN_MODE = ColorMode::rgb565;
-
-    const size_t BLOCK_WIDTH = 2;
-    const size_t BLOCK_HEIGHT = 2;
-    const size_t PLAYER_WIDTH = 4;
-    const size_t PLAYER_HEIGHT = 2;
-    const size_t GAMEBOARD_Y = 12;
-#endif
+const size_t SCREEN_WIDTH = 160;
+const size_t SCREEN_HEIGHT = 128;
+const ColorMode SCREEN_MODE = ColorMode::index;
+
+const size_t BLOCK_WIDTH = 4;
+const size_t BLOCK_HEIGHT = 5;
+const size_t PLAYER_WIDTH = 8;
+const size_t PLAYER_HEIGHT = 5;
+const size_t GAMEBOARD_Y = 16;
+
+/* Low resolution profile, selectable at run time: the gameplay screen only, drawn by the low resolution
+ * renderer at half the width, with 2x2 blocks. The HUD bars keep their height. */
+const size_t LOWRES_SCREEN_WIDTH = 80;
+const size_t LOWRES_SCREEN_HEIGHT = 64;
+const ColorMode LOWRES_SCREEN_MODE = ColorMode::rgb565;
+
+const size_t LOWRES_BLOCK_WIDTH = 2;
+const size_t LOWRES_BLOCK_HEIGHT = 2;
+const size_t LOWRES_PLAYER_WIDTH = 4;
+const size_t LOWRES_PLAYER_HEIGHT = 2;
+const size_t LOWRES_GAMEBOARD_Y = 12;
+
+/* Both profiles share the framebuffer memory */
+static_assert(LOWRES_SCREEN_WIDTH * LOWRES_SCREEN_HEIGHT * 2 <= SCREEN_WIDTH * SCREEN_HEIGHT / 2);
+static_assert(LOWRES_GAMEBOARD_Y + NUM_ROWS * LOWRES_BLOCK_HEIGHT + (SCREEN_HEIGHT - GAMEBOARD_Y - NUM_ROWS * BLOCK_HEIGHT)
+        == LOWRES_SCREEN_HEIGHT);
 
 
 #endif // SST_CONFIGURATION_H
@@ -0,0 +1,207 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#include "DisplayList.h"
+#include "Configuration.h"
+#include "GameContext.h"
+#include "Tileset.h"
+#include "Raster.h"
+#include "Starfield.h"
+#include "Hud.h"
+#include "Gamebuino-Meta-ADTCRV.h"
+
+namespace spaceshoot { namespace displaylist {
+
+    using ElementID = tileset::ElementID;
+
+    enum struct Kind: uint8_t {
+        Pixel, Tile, Hud, Starfield, GameField
+    };
+
+    struct Entry {
+        int16_t x;
+        uint8_t y;          /* First scanline */
+        uint8_t height;     /* Number of scanlines */
+        Kind kind;
+        uint8_t value;      /* Color or tile ID, depending on the kind */
+        uint8_t next;       /* Next entry starting at the same scanline */
+    };
+
+    const uint8_t NO_ENTRY = 0xFF;
+    const uint8_t MISSILE_COLOR = 12;
+    static_assert(MAX_ENTRIES < NO_ENTRY);
+    static_assert(SCREEN_HEIGHT <= 256);
+
+    static Entry entries[MAX_ENTRIES];
+    static uint8_t entryCount;
+
+    /* For each scanline, the entries starting at it, in the order of adding */
+    static uint8_t bucketHead[SCREEN_HEIGHT];
+    static uint8_t bucketTail[SCREEN_HEIGHT];
+
+    static context::game::Context* gameField;
+    static uint8_t gameFieldDx;
+    static bool starfieldAdded;
+    static uint32_t starfieldFrame;
+
+    void clear() {
+        memset(bucketHead, NO_ENTRY, sizeof(bucketHead));
+        entryCount = 0;
+        gameField = nullptr;
+        starfieldAdded = false;
+    }
+
+    static bool add(int16_t x, int16_t y, uint8_t height, Kind kind, uint8_t value) {
+        /* Clip vertically, whatever is above the screen is dropped together with the entry */
+        if (entryCount >= MAX_ENTRIES || y < 0 || y >= (int16_t)SCREEN_HEIGHT) {
+            return false;
+        }
+        Entry& entry = entries[entryCount];
+        entry.x = x;
+        entry.y = y;
+        entry.height = y + height > (int16_t)SCREEN_HEIGHT ? SCREEN_HEIGHT - y : height;
+        entry.kind = kind;
+        entry.value = value;
+        entry.next = NO_ENTRY;
+
+        if (bucketHead[y] == NO_ENTRY) {
+            bucketHead[y] = entryCount;
+        } else {
+            entries[bucketTail[y]].next = entryCount;
+        }
+        bucketTail[y] = entryCount;
+        entryCount++;
+        return true;
+    }
+
+    void addPixel(int16_t x, int16_t y, uint8_t color) {
+        if (x >= 0 && x < (int16_t)SCREEN_WIDTH) {
+            add(x, y, 1, Kind::Pixel, color);
+        }
+    }
+
+    void addTile(int16_t x, int16_t y, tileset::ElementID id) {
+        /* Fully transparent tiles are not worth an entry */
+        if (id != ElementID::None) {
+            add(x, y, BLOCK_HEIGHT, Kind::Tile, static_cast<uint8_t>(id));
+        }
+    }
+
+    void addHud(int16_t y, uint8_t height) {
+        add(0, y, height, Kind::Hud, 0);
+    }
+
+    void addStarfield(uint32_t frame) {
+        starfieldAdded = add(0, GAMEBOARD_Y, NUM_ROWS * BLOCK_HEIGHT, Kind::Starfield, 0);
+        starfieldFrame = frame;
+    }
+
+    void addGameField(context::game::Context& ctx, uint8_t spriteDx) {
+        gameField = &ctx;
+        gameFieldDx = spriteDx;
+        add(0, GAMEBOARD_Y, NUM_ROWS * BLOCK_HEIGHT, Kind::GameField, 0);
+    }
+
+    using raster::setPixel;
+
+    static void rasterizeGameField(uint8_t* line, uint8_t row) {
+        context::game::Context& ctx = *gameField;
+        const uint8_t fieldRow = row / BLOCK_HEIGHT;
+        const uint8_t tileRow = row % BLOCK_HEIGHT;
+        const bool missileRow = tileRow >= 1 && tileRow < BLOCK_HEIGHT - 1;
+
+        int16_t drawX = PLAYER_WIDTH + NUM_COLS * BLOCK_WIDTH;
+        for (size_t col = NUM_COLS - 1; col < NUM_COLS; col--) {
+            tileset::drawRow(line, drawX - gameFieldDx, context::game::getBlock(ctx, fieldRow, col), tileRow);
+
+            if (missileRow && context::game::getMissile(ctx, fieldRow, col) && drawX + 1 < (int16_t)SCREEN_WIDTH) {
+                setPixel(line, drawX + 1, MISSILE_COLOR);
+            }
+            drawX -= BLOCK_WIDTH;
+        }
+    }
+
+    /* Entries covering the current scanline, sorted by their index (painter's order) */
+    static uint8_t active[MAX_ENTRIES];
+    static uint8_t activeCount;
+    static uint8_t currentLine;
+
+    void beginRasterize() {
+        activeCount = 0;
+        currentLine = 0;
+        if (starfieldAdded) {
+            starfield::beginRows(starfieldFrame);
+        }
+    }
+
+    void rasterizeLine(uint8_t* line) {
+        const uint8_t y = currentLine++;
+
+        for (uint8_t ix = bucketHead[y]; ix != NO_ENTRY; ix = entries[ix].next) {
+            uint8_t pos = activeCount++;
+            while (pos > 0 && active[pos - 1] > ix) {
+                active[pos] = active[pos - 1];
+                pos--;
+            }
+            active[pos] = ix;
+        }
+
+        memset(line, 0, SCREEN_WIDTH / 2);
+
+        uint8_t kept = 0;
+        for (uint8_t ax = 0; ax < activeCount; ax++) {
+            const Entry& entry = entries[active[ax]];
+            uint8_t row = y - entry.y;
+
+            switch (entry.kind) {
+            case Kind::Pixel:
+                setPixel(line, entry.x, entry.value);
+                break;
+            case Kind::Tile:
+                tileset::drawRow(line, entry.x, static_cast<ElementID>(entry.value), row);
+                break;
+            case Kind::Hud:
+                hud::drawRow(line, y);
+                break;
+            case Kind::Starfield:
+                starfield::drawRow(line, y);
+                break;
+            case Kind::GameField:
+                rasterizeGameField(line, row);
+                break;
+            }
+
+            if (row + 1 < entry.height) {
+                active[kept++] = active[ax];
+            }
+        }
+        activeCount = kept;
+    }
+
+    void rasterize(uint8_t* framebuffer) {
+        beginRasterize();
+        for (uint8_t y = 0; y < SCREEN_HEIGHT; y++) {
+            rasterizeLine(framebuffer + y * (SCREEN_WIDTH / 2));
+        }
+    }
+
+}} // namespace spaceshoot::displaylist
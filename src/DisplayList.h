@@ -0,0 +1,57 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#ifndef SST_DISPLAYLIST_H
+#define SST_DISPLAYLIST_H
+
+#include "Configuration.h"
+#include "GameContext.h"
+#include "Tileset.h"
+#include <stdint.h>
+
+namespace spaceshoot { namespace displaylist {
+
+    /* Entries are rasterized in the order they were added, so they should be added in painter's order */
+    const size_t MAX_ENTRIES = 160;
+
+    void clear();
+
+    void addPixel(int16_t x, int16_t y, uint8_t color);
+    void addTile(int16_t x, int16_t y, tileset::ElementID id);
+    /* The HUD fields (see hud::drawRow()) on the given lines */
+    void addHud(int16_t y, uint8_t height);
+    /* The stars of the background at the given frame, as a single entry covering the game field */
+    void addStarfield(uint32_t frame);
+    /* The whole game field (blocks and missiles) as a single tile map entry */
+    void addGameField(context::game::Context& ctx, uint8_t spriteDx);
+
+    /* Clears and draws the screen top to bottom, one framebuffer line at a time */
+    void rasterize(uint8_t* framebuffer);
+
+    /* The same for renderers without a framebuffer: after beginRasterize(), every rasterizeLine() call
+     * clears and draws the next line of the screen into the given line buffer */
+    void beginRasterize();
+    void rasterizeLine(uint8_t* line);
+
+}} // namespace spaceshoot::displaylist
+
+#endif // SST_DISPLAYLIST_H
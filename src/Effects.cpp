@@ -0,0 +1,135 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#include "Effects.h"
+#include "Configuration.h"
+#include "Gamebuino-Meta-ADTCRV.h"
+#include <string.h>
+
+namespace spaceshoot { namespace effects {
+
+    /* From halfway between the body and the stripe color of the tile to the stripe color and back, at the pace
+     * the tile used to be animated with */
+    static const uint16_t BONUS_GLOW[4] = {0x05c0, 0x0660, 0x0700, 0x0660};
+    const uint8_t BONUS_GLOW_SPEED = 3;
+
+    /* The salvo lasts 4 frames */
+    const uint8_t SWEEP_ROWS = NUM_ROWS / 4;
+
+    static uint16_t glowColors[16];
+    static uint16_t flashColors[FLASH_LEVELS][16];
+
+    /* Flash level of every row, it drops by one every frame */
+    static uint8_t rowFlash[NUM_ROWS];
+    static uint8_t screenFlash;
+    /* First row of the next step of the sweep, NUM_ROWS when there is none */
+    static uint8_t sweepRow;
+
+    /* Moves the color towards white by level/12 */
+    static inline uint16_t brighten(uint16_t color, uint8_t level) {
+        uint16_t r = color >> 11;
+        uint16_t g = (color >> 5) & 0x3F;
+        uint16_t b = color & 0x1F;
+        r += (0x1F - r) * level / 12;
+        g += (0x3F - g) * level / 12;
+        b += (0x1F - b) * level / 12;
+        return (r << 11) | (g << 5) | b;
+    }
+
+    void begin(const uint16_t* tilesPalette) {
+        memcpy(glowColors, tilesPalette, sizeof(glowColors));
+        gb.tft.colorCells.palettes[SLOT_GLOW] = (Color*)glowColors;
+        for (uint8_t level = 0; level < FLASH_LEVELS; level++) {
+            gb.tft.colorCells.palettes[SLOT_FLASH + level] = (Color*)flashColors[level];
+        }
+        memset(rowFlash, 0, sizeof(rowFlash));
+        screenFlash = 0;
+        sweepRow = NUM_ROWS;
+    }
+
+    void end() {
+        memset(rowFlash, 0, sizeof(rowFlash));
+        screenFlash = 0;
+        sweepRow = NUM_ROWS;
+        memset(gb.tft.colorCells.paletteToLine + GAMEBOARD_Y, 0, NUM_ROWS * BLOCK_HEIGHT);
+    }
+
+    void updateGlow() {
+        glowColors[INDEX_BONUS_GLOW] = BONUS_GLOW[(gb.frameCount / BONUS_GLOW_SPEED) % 4];
+    }
+
+    void flashRow(uint8_t row) {
+        rowFlash[row] = FLASH_LEVELS;
+    }
+
+    void sweepRows() {
+        sweepRow = 0;
+    }
+
+    void flashScreen() {
+        screenFlash = FLASH_LEVELS;
+    }
+
+    void update(uint32_t glowRows) {
+        updateGlow();
+
+        for (uint8_t row = sweepRow; row < sweepRow + SWEEP_ROWS && row < NUM_ROWS; row++) {
+            rowFlash[row] = FLASH_LEVELS;
+        }
+        if (sweepRow < NUM_ROWS) {
+            sweepRow += SWEEP_ROWS;
+        }
+
+        bool flashing = false;
+        uint8_t* paletteToLine = gb.tft.colorCells.paletteToLine + GAMEBOARD_Y;
+        for (uint8_t row = 0; row < NUM_ROWS; row++) {
+            const uint8_t level = rowFlash[row] > screenFlash ? rowFlash[row] : screenFlash;
+            uint8_t slot = 0;
+            if (level > 0) {
+                slot = SLOT_FLASH + level - 1;
+                flashing = true;
+            } else if (glowRows & (static_cast<uint32_t>(1) << row)) {
+                slot = SLOT_GLOW;
+            }
+            memset(paletteToLine + row * BLOCK_HEIGHT, slot, BLOCK_HEIGHT);
+            if (rowFlash[row] > 0) {
+                rowFlash[row]--;
+            }
+        }
+        if (screenFlash > 0) {
+            screenFlash--;
+        }
+
+        if (flashing) {
+            for (uint8_t level = 0; level < FLASH_LEVELS; level++) {
+                for (uint8_t ix = 0; ix < 16; ix++) {
+                    flashColors[level][ix] = brighten(glowColors[ix], level + 1);
+                }
+            }
+        }
+    }
+
+    const uint16_t* glowPalette() {
+        return glowColors;
+    }
+
+}} // namespace spaceshoot::effects
@@ -0,0 +1,67 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#ifndef SST_EFFECTS_H
+#define SST_EFFECTS_H
+
+#include "Configuration.h"
+#include <stdint.h>
+
+/* On-screen feedback of the game that only changes palettes: the rows of the game field switch between palette
+ * slots through gb.tft.colorCells, the pixels stay as they are. */
+namespace spaceshoot { namespace effects {
+
+    /* Slot 0 holds the tileset palette as it is, slots 1-8 the HUD bars */
+    const uint8_t SLOT_GLOW = 9;
+    const uint8_t SLOT_FLASH = 10;
+    const uint8_t FLASH_LEVELS = 3;
+
+    /* Tileset palette entry that shimmers in the rows holding a bonus, no other tile uses it. The bombs keep
+     * their tile animation: their stripe color is shared with the ship tail and the stoned bombs. */
+    const uint8_t INDEX_BONUS_GLOW = 9;
+
+    /* Sets up the effect palettes after the tileset palette, with no effect running. The lines keep their
+     * palettes until the first update(). */
+    void begin(const uint16_t* tilesPalette);
+    /* Takes every row back to the tileset palette, for the fades at the end of the game */
+    void end();
+
+    void flashRow(uint8_t row);
+    /* The flash runs over all the rows, from the top */
+    void sweepRows();
+    void flashScreen();
+
+    /* Once per frame: advances the effects and assigns a palette to every line of the game field. glowRows has
+     * a bit set for each row holding a bonus. */
+    void update(uint32_t glowRows);
+    /* Only advances the shimmer colors, for the lines given SLOT_GLOW outside the game field */
+    void updateGlow();
+
+    /* The tileset palette with the current shimmer colors */
+    const uint16_t* glowPalette();
+
+    static_assert(SLOT_FLASH + FLASH_LEVELS <= 32);
+    static_assert(NUM_ROWS <= 32);
+
+}} // namespace spaceshoot::effects
+
+#endif // SST_EFFECTS_H
@@ -17,13 +17,13 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>
  */
  
-#ifndef FONT4X7_C
-#define FONT4X7_C
+#ifndef SST_FONT4X7_H
+#define SST_FONT4X7_H
 
 #include <stdint.h>
 
 // standard ascii 4x7 font
-const uint8_t font4x7[] = {4, 7,
+constexpr uint8_t font4x7[] = {4, 7,
     0x00, 0x00, 0x00, 0x00,  // 0x00
     0x3e, 0x7f, 0x41, 0x75,  // 0x01
     0x3e, 0x7f, 0x41, 0x55,  // 0x02
@@ -154,4 +154,4 @@ const uint8_t font4x7[] = {4, 7,
     0x00, 0x00, 0x00, 0x00,  // 0x7f
 };
 
-#endif
+#endif // SST_FONT4X7_H
@@ -24,9 +24,18 @@
 #include "Configuration.h"
 #include "Utils.h"
 #include "Tileset.h"
+#include "Particles.h"
+#include "Starfield.h"
+#include "Hud.h"
+#include "DisplayList.h"
+#include "Sprites.h"
+#include "StripRenderer.h"
+#include "LowResRenderer.h"
+#include "Effects.h"
+#include "Raster.h"
 #include "Gamebuino-Meta-ADTCRV.h"
 #include "utility/Misc/Misc.h"
-#include "utility/Graphics/font3x5.c"
+#include "Font3x5.h"
 
 namespace spaceshoot { namespace context { namespace game {
 
@@ -82,14 +91,36 @@ using ElementID = tileset::ElementID;
     const ColorIndex COLOR_SCORE = (ColorIndex)1;
     const ColorIndex COLOR_BOMBS = (ColorIndex)2;
     const ColorIndex COLOR_TIME = (ColorIndex)3;
+    const uint8_t MISSILE_COLOR = 12;
+
+    const int16_t FIELD_BOTTOM = GAMEBOARD_Y + NUM_ROWS * BLOCK_HEIGHT;
 
     const size_t PLAYER_TILE_TAIL = 0;
     const size_t PLAYER_TILE_FRONT = 1;
     const size_t PLAYER_TILE_FRONT_LEFT = 2;
     const size_t PLAYER_TILE_FRONT_RIGHT = 3;
 
+    /* Sprite layer slots */
+    const uint8_t SPRITE_TAIL_FIRE = 0;
+    const uint8_t SPRITE_SHIP = 1;
+    const uint8_t SPRITE_GLOWS = 2;
+
+    const uint8_t HUD_SCORE = 0;
+    const uint8_t HUD_BOMBS = 1;
+    const uint8_t HUD_TIME = 2;
+    const uint8_t HUD_PROFILING = 3;
+
+    static inline int16_t cellCenterX(uint8_t col) {
+        return PLAYER_WIDTH + (col + 1) * BLOCK_WIDTH + BLOCK_WIDTH / 2;
+    }
+
+    static inline int16_t cellCenterY(uint8_t row) {
+        return GAMEBOARD_Y + row * BLOCK_HEIGHT + BLOCK_HEIGHT / 2;
+    }
+
     void restart(Context& ctx) {
-        memset(reinterpret_cast<void*>(&ctx.playerPosition), 0, sizeof(ctx) - 2);
+        /* Settings are kept across games */
+        memset(reinterpret_cast<void*>(&ctx.playerPosition), 0, sizeof(ctx) - offsetof(Context, playerPosition));
         ctx.playerPosition = NUM_ROWS / 2;
     }
 
@@ -105,6 +136,7 @@ using ElementID = tileset::ElementID;
         case ElementID::Debris7:
         case ElementID::Debris8:
             illumination |= (1 << (4 + ROW_TO_LED[row]));
+            effects::flashRow(row);
 
             ctx.score += 5;
             return true;
@@ -114,6 +146,7 @@ using ElementID = tileset::ElementID;
         case ElementID::Bomb3:
         case ElementID::Bomb4:
             illumination |= ILLUM_BOMB_BITMASK;
+            effects::flashRow(row);
             ctx.score += 5;
             ctx.bombsCollected++;
             ctx.numBombs++;
@@ -125,6 +158,7 @@ using ElementID = tileset::ElementID;
         case ElementID::Bonus3:
         case ElementID::Bonus4:
             illumination |= ILLUM_BONUS_BITMASK;
+            effects::flashScreen();
             ctx.score += 125;
             ctx.bonusBlocksCollected++;
            // gb.sound.tone(1000, 4000);
@@ -167,6 +201,7 @@ using ElementID = tileset::ElementID;
                 ctx.hits++;
                 ctx.blocksPresent--;
                 game::setBlockClearMissile(ctx, row, col, ElementID::Destroyed1);
+                particles::spawnHitSparks(cellCenterX(col), cellCenterY(row));
                 hits++;
             }
         }
@@ -178,6 +213,7 @@ using ElementID = tileset::ElementID;
 
         uint16_t hits = 0;
         bool miss = false;
+        ctx.bonusRows = 0;
 
         for (size_t row = 0; row < NUM_ROWS; row++) {
 
@@ -195,6 +231,9 @@ using ElementID = tileset::ElementID;
 
                 /* Handle stoning of function blocks and update of animated tiles */
                 auto& animSeq = tileset::animSequences[static_cast<size_t>(blk)];
+                if (game::isBonusBlock(blk)) {
+                    ctx.bonusRows |= static_cast<uint32_t>(1) << row;
+                }
                 if (blk != ElementID::None) {
                     /* TODO: magic number */
                     if (game::isFunctionBlock(blk) && col == 19) {
@@ -214,10 +253,13 @@ using ElementID = tileset::ElementID;
                 if (blk != ElementID::None && !(blk >= ElementID::Destroyed1 && blk <= ElementID::Destroyed5)) {
                     return GameState::GameOverLost;
                 }
+                /* The renderer moves the framebuffer together with the blocks, so only the changes made
+                 * before the move need to follow them. Missiles stay in place, hence the cells are kept as well. */
+                ctx.dirtyCells[row] |= ctx.dirtyCells[row] >> 1;
                 for (size_t col = 0; col < NUM_COLS-1; col++) {
-                    game::setBlock(ctx, row, col,
-                            game::getBlock(ctx, row, col + 1));
+                    ctx.gameField[row][col] = (ctx.gameField[row][col] & ~BLOCK_MASK) | (ctx.gameField[row][col + 1] & BLOCK_MASK);
                 }
+                ctx.scrolled = true;
                 size_t col = NUM_COLS - 1;
                 int randval = rand();
 
@@ -245,6 +287,9 @@ using ElementID = tileset::ElementID;
                     } 
 
                     if (blockPlaced) ctx.blocksPresent++;
+                    if (game::isBonusBlock(game::getBlock(ctx, row, col))) {
+                        ctx.bonusRows |= static_cast<uint32_t>(1) << row;
+                    }
                 } else {
                     game::setBlock(ctx, row, col, ElementID::None);
                 }
@@ -283,6 +328,7 @@ using ElementID = tileset::ElementID;
       if (ctx.numBombs > 0) {
         ctx.salvoCounter += 4;
         ctx.numBombs--;
+        effects::sweepRows();
       }
     }
 
@@ -291,6 +337,7 @@ using ElementID = tileset::ElementID;
             gb.sound.tone(ctx.salvoCounter * 150, 50);
             for (size_t row = 0; row < NUM_ROWS; row++) {
                 setMissile(ctx, row, 0, true);
+                particles::spawnSalvoFlash(PLAYER_WIDTH + BLOCK_WIDTH, cellCenterY(row));
             }
             ctx.salvoCounter--;
             ctx.shoots += NUM_ROWS;
@@ -332,11 +379,15 @@ using ElementID = tileset::ElementID;
         playerTiles[PLAYER_TILE_FRONT_RIGHT] = tileset::ElementID::None;
     }
 
-    static inline void drawGameField(Context& ctx, Image& tileSet) {
-        size_t spriteDx = 0;
+    static inline uint8_t getSpriteDx(Context& ctx) {
         if (ctx.flags & FLAG_SMOOTH_SCROLLING) {
-            spriteDx = ((ctx.runTime - 1) >> 1) & 0x03;
+            return ((ctx.runTime - 1) >> 1) & 0x03;
         }
+        return 0;
+    }
+
+    static inline void drawGameField(Context& ctx) {
+        size_t spriteDx = getSpriteDx(ctx);
 
         size_t drawY = GAMEBOARD_Y;
 
@@ -347,12 +398,11 @@ using ElementID = tileset::ElementID;
                 auto blk = getBlock(ctx, y, x);
 
                 if (blk != ElementID::None) {
-                    tileset::draw(tileSet, drawX - spriteDx, drawY, blk);
+                    tileset::draw(drawX - spriteDx, drawY, blk);
                 }
 
                 if (getMissile(ctx, y, x)) {
-                    gb.display.setColor(12);
-                    gb.display.drawFastVLine(drawX + 1, drawY + 1, BLOCK_HEIGHT - 2);
+                    raster::drawVLine(raster::framebuffer(), drawX + 1, drawY + 1, BLOCK_HEIGHT - 2, MISSILE_COLOR);
                 }
 
                 drawX -= BLOCK_WIDTH;
@@ -362,58 +412,128 @@ using ElementID = tileset::ElementID;
         }
     }
 
-    static inline void drawBorders(Context& ctx) {
-        const DifficultyLevelParams& params = DIFFICULTIES[ctx.difficultyLevel];
-
-        gb.display.setFont(font3x5);
-        gb.display.setFontSize(2, 1);
-
-        gb.display.setColor(COLOR_SCORE);
-        gb.display.printf(0, 0, "%5d", ctx.score);
+    static inline void initHud() {
+        hud::init(font3x5);
+        hud::setField(HUD_SCORE, 0, 0, 2, (uint8_t)COLOR_SCORE, 7);
+        hud::setField(HUD_BOMBS, 60, 0, 2, (uint8_t)COLOR_BOMBS, 3);
+        hud::setField(HUD_TIME, 120, 0, 2, (uint8_t)COLOR_TIME, 5);
+        hud::setField(HUD_PROFILING, 0, SCREEN_HEIGHT - 7, 1, (uint8_t)COLOR_SCORE, SCREEN_WIDTH / 4);
+    }
 
-        if (ctx.numBombs > 0) {
-            gb.display.setColor(COLOR_BOMBS);
-            gb.display.printf(60, 0, "%2d", ctx.numBombs);
+    /* Formats the HUD texts, the same way as printf() with "%5d", "%2d", "%d:%02d" and the profiling line
+     * format would */
+    static void updateHud(Context& ctx) {
+        const DifficultyLevelParams& params = DIFFICULTIES[ctx.difficultyLevel];
+        /* Long enough for all the numbers at their maximum values */
+        char str[64];
+        uint8_t n;
+
+        n = hud::formatNumber(str, ctx.score, 5);
+        str[n] = '\0';
+        hud::setText(HUD_SCORE, str);
+
+        n = ctx.numBombs > 0 ? hud::formatNumber(str, ctx.numBombs, 2) : 0;
+        str[n] = '\0';
+        hud::setText(HUD_BOMBS, str);
+
+        unsigned int seconds = (params.maxRunTime - ctx.runTime) / TARGET_FPS;
+        unsigned int minutes = 0;
+        while (seconds >= 60) {
+            seconds -= 60;
+            minutes++;
         }
+        n = hud::formatNumber(str, minutes, 1);
+        str[n++] = ':';
+        if (seconds < 10) {
+            str[n++] = '0';
+        }
+        n += hud::formatNumber(str + n, seconds, 1);
+        str[n] = '\0';
+        hud::setText(HUD_TIME, str);
 
-        unsigned int remainingTime = (params.maxRunTime - ctx.runTime) / TARGET_FPS;
-        gb.display.setColor(COLOR_TIME);
-        gb.display.printf(120, 0, "%d:%02d", remainingTime / 60, remainingTime % 60);
-
+        n = 0;
         if (ctx.flags & FLAG_SHOW_PROFILING_INFO) {
-            gb.display.setFontSize(1, 1);
             /* Profiling information for nerds */
-            gb.display.setColor(COLOR_SCORE);
             uint32_t fps = 10000000 / gb.frameDurationMicros;
-            //if (fps > TARGET_FPS * 100) {
-            //  fps = TARGET_FPS * 100;
-            //}
-            gb.display.printf(0, SCREEN_HEIGHT-7, "MFPS: %2d.%d, B: %3d, H/S: %4d/%4d",
-                    fps / 10, fps % 10, ctx.blocksPresent, ctx.hits, ctx.shoots);
+            memcpy(str, "MFPS: ", 6);
+            n = 6 + hud::formatNumber(str + 6, fps, 3);
+            /* Tenths of a frame per second: the last digit goes after a decimal point */
+            if (str[n - 2] == ' ') {
+                str[n - 2] = '0';
+            }
+            str[n] = str[n - 1];
+            str[n - 1] = '.';
+            n++;
+            memcpy(str + n, ", B: ", 5);
+            n += 5;
+            n += hud::formatNumber(str + n, ctx.blocksPresent, 3);
+            memcpy(str + n, ", H/S: ", 7);
+            n += 7;
+            n += hud::formatNumber(str + n, ctx.hits, 4);
+            str[n++] = '/';
+            n += hud::formatNumber(str + n, ctx.shoots, 4);
+            memcpy(str + n, " P:", 3);
+            n += 3;
+            n += hud::formatNumber(str + n, particles::count(), 2);
         }
+        str[n] = '\0';
+        hud::setText(HUD_PROFILING, str);
     }
 
-    static inline void drawPlayer(uint8_t playerPositionX, uint8_t playerPositionY, tileset::ElementID* playerTiles, Image& tileSet) {
-        size_t drawY = GAMEBOARD_Y;
-        for (unsigned int y = 0; y < NUM_ROWS; y++) {
-            if (y == playerPositionY - 1) {
-                tileset::draw(tileSet, playerPositionX + BLOCK_WIDTH, drawY, playerTiles[PLAYER_TILE_FRONT_LEFT]);
-            } else if (y == playerPositionY) {
-                tileset::draw(tileSet, playerPositionX, drawY, playerTiles[PLAYER_TILE_TAIL]);
-                tileset::draw(tileSet, playerPositionX + BLOCK_WIDTH, drawY, playerTiles[PLAYER_TILE_FRONT]);
-            } else if (y == playerPositionY + 1) {
-                tileset::draw(tileSet, playerPositionX + BLOCK_WIDTH, drawY, playerTiles[PLAYER_TILE_FRONT_RIGHT]);
-            } else {
-                tileset::draw(tileSet, playerPositionX, drawY, ElementID::None);
-                tileset::draw(tileSet, playerPositionX + BLOCK_WIDTH, drawY, ElementID::None);
-            }
-            drawY += PLAYER_HEIGHT;
-        }
-        if (playerPositionX >= BLOCK_WIDTH) {
-            tileset::draw(tileSet, playerPositionX - BLOCK_WIDTH, playerPositionY * PLAYER_HEIGHT + GAMEBOARD_Y, ElementID::ShipTailFire);
+    static inline void drawBorders(Context& ctx) {
+        updateHud(ctx);
+        hud::draw(raster::framebuffer());
+    }
+
+    static inline void initPlayerSprites() {
+        sprites::reset();
+        sprites::get(SPRITE_TAIL_FIRE).z = 0;
+        sprites::get(SPRITE_SHIP).z = 1;
+        sprites::get(SPRITE_GLOWS).z = 2;
+    }
+
+    static inline void updatePlayerSprites(uint8_t playerPositionX, uint8_t playerPositionY, tileset::ElementID* playerTiles) {
+        const int16_t drawY = GAMEBOARD_Y + playerPositionY * PLAYER_HEIGHT;
+
+        sprites::Sprite& ship = sprites::get(SPRITE_SHIP);
+        ship.x = playerPositionX;
+        ship.y = drawY;
+        ship.visible = true;
+        sprites::setTile(ship, 0, 0, 0, playerTiles[PLAYER_TILE_TAIL]);
+        sprites::setTile(ship, 1, BLOCK_WIDTH, 0, playerTiles[PLAYER_TILE_FRONT]);
+
+        /* The glows next to the front are not drawn outside of the field */
+        sprites::Sprite& glows = sprites::get(SPRITE_GLOWS);
+        glows.x = playerPositionX + BLOCK_WIDTH;
+        glows.y = drawY;
+        glows.visible = true;
+        sprites::setTile(glows, 0, 0, -(int8_t)PLAYER_HEIGHT,
+                playerPositionY > 0 ? playerTiles[PLAYER_TILE_FRONT_LEFT] : ElementID::None);
+        sprites::setTile(glows, 1, 0, PLAYER_HEIGHT,
+                playerPositionY < NUM_ROWS - 1 ? playerTiles[PLAYER_TILE_FRONT_RIGHT] : ElementID::None);
+
+        sprites::Sprite& tailFire = sprites::get(SPRITE_TAIL_FIRE);
+        tailFire.x = playerPositionX - BLOCK_WIDTH;
+        tailFire.y = drawY;
+        tailFire.visible = playerPositionX >= BLOCK_WIDTH;
+        sprites::setTile(tailFire, 0, 0, 0, ElementID::ShipTailFire);
+    }
+
+    /* Display list counterparts of drawBorders(), drawBackground(), drawGameField() and sprites::draw() */
+    static void buildDisplayList(Context& ctx) {
+        displaylist::clear();
+
+        updateHud(ctx);
+        displaylist::addHud(0, GAMEBOARD_Y);
+        displaylist::addHud(FIELD_BOTTOM, SCREEN_HEIGHT - FIELD_BOTTOM);
+
+        if (ctx.flags & FLAG_SHOW_BACKGROUND) {
+            displaylist::addStarfield(gb.frameCount);
         }
-        /* Update animated tiles */
-        updateAnimation(playerTiles, 4);
+
+        displaylist::addGameField(ctx, getSpriteDx(ctx));
+
+        sprites::forEachTile(displaylist::addTile);
     }
 
     static inline void handleButtons(Context& ctx, tileset::ElementID* playerTiles, DrawScene& drawScene) {
@@ -537,56 +657,242 @@ using ElementID = tileset::ElementID;
         }
     }
     
-    static void drawBackground(uint16_t background[64]) {
-        static const ColorIndex COLORS[4] = {
-            (ColorIndex)2, (ColorIndex)13, (ColorIndex)7, (ColorIndex)14,
-        };
-        for (uint8_t ix = 0; ix < 64; ix++) {
-            uint8_t x = background[ix] & 0xFF;
-            uint8_t y = (background[ix] >> 8) & 0x3F;
-            uint8_t c = (background[ix] >> 14) & 0x03;
+    static inline void clearRect(int16_t x, int16_t y, int16_t w, int16_t h) {
+        raster::fillRect(raster::framebuffer(), x, y, w, h, 0);
+    }
+
+    static inline void drawMissileInCell(Context& ctx, uint8_t row, uint8_t missileCol, int16_t cellX, int16_t drawY) {
+        int16_t missileX = PLAYER_WIDTH + (missileCol + 1) * BLOCK_WIDTH + 1;
+        if (getMissile(ctx, row, missileCol) && missileX >= cellX && missileX < cellX + (int16_t)BLOCK_WIDTH) {
+            raster::drawVLine(raster::framebuffer(), missileX, drawY + 1, BLOCK_HEIGHT - 2, MISSILE_COLOR);
+        }
+    }
+
+    /* Marks the cell covering the given screen position, if any */
+    static inline void markDirtyAt(Context& ctx, int16_t fieldLeft, int16_t x, int16_t y) {
+        if (x >= fieldLeft && x < (int16_t)SCREEN_WIDTH && y >= (int16_t)GAMEBOARD_Y && y < FIELD_BOTTOM) {
+            markDirty(ctx, (y - GAMEBOARD_Y) / BLOCK_HEIGHT, (x - fieldLeft) / BLOCK_WIDTH);
+        }
+    }
+
+    /* Particles drawn in the previous frame have been moved left by scrollDelta pixels. Those in the field
+     * are erased by redrawing their cells, the ones left of it are cleared right away. */
+    static void eraseParticles(Context& ctx, int16_t fieldLeft, uint8_t scrollDelta) {
+        for (size_t ix = 0; ix < particles::count(); ix++) {
+            int16_t x, y;
+            particles::getPosition(ix, x, y);
+            x -= scrollDelta;
+            if (x >= 0 && x < fieldLeft && y >= (int16_t)GAMEBOARD_Y && y < FIELD_BOTTOM) {
+                clearRect(x, y, 1, 1);
+            } else {
+                markDirtyAt(ctx, fieldLeft, x, y);
+            }
+        }
+    }
+
+    /* Clears the boxes the sprites were drawn at, the parts overlapping the field are marked dirty instead */
+    static void eraseSprites(Context& ctx, int16_t fieldLeft) {
+        for (uint8_t ix = 0; ix < sprites::MAX_SPRITES; ix++) {
+            const sprites::Box& box = sprites::get(ix).drawnBox;
+            if (box.w == 0) {
+                continue;
+            }
+
+            int16_t x0 = box.x < 0 ? 0 : box.x;
+            int16_t x1 = box.x + box.w < fieldLeft ? box.x + box.w : fieldLeft;
+            if (x0 < x1) {
+                clearRect(x0, box.y, x1 - x0, box.h);
+            }
+
+            const int16_t right = box.x + box.w - 1;
+            const int16_t bottom = box.y + box.h - 1;
+            for (int16_t y = box.y; ; y += BLOCK_HEIGHT) {
+                if (y > bottom) y = bottom;
+                for (int16_t x = box.x; ; x += BLOCK_WIDTH) {
+                    if (x > right) x = right;
+                    markDirtyAt(ctx, fieldLeft, x, y);
+                    if (x == right) break;
+                }
+                if (y == bottom) break;
+            }
+        }
+    }
 
-            x += (gb.frameCount >> 3);
+    /* Marks the cells with the stars of the previous frame, as moved by the scroll, and with the current ones */
+    static void markStarsDirty(Context& ctx, int16_t fieldLeft, uint8_t scrollDelta, uint32_t previousFrame) {
+        for (size_t ix = 0; ix < starfield::count(); ix++) {
+            int16_t x, previousX, y;
+            starfield::getPosition(ix, gb.frameCount, x, y);
+            starfield::getPosition(ix, previousFrame, previousX, y);
+
+            markDirtyAt(ctx, fieldLeft, x, y);
+            if (previousX < (int16_t)SCREEN_WIDTH) {
+                markDirtyAt(ctx, fieldLeft, previousX - scrollDelta, y);
+            }
+        }
+    }
+
+    static inline uint64_t getMissileMask(Context& ctx, uint8_t row) {
+        uint64_t mask = 0;
+        for (size_t col = 0; col < NUM_COLS; col++) {
+            if (getMissile(ctx, row, col)) {
+                mask |= static_cast<uint64_t>(1) << col;
+            }
+        }
+        return mask;
+    }
 
-            if (x < SCREEN_WIDTH) {
-                gb.display.drawPixel(x, GAMEBOARD_Y + y * 2, COLORS[c]);
+    /* Missile lines do not move with the blocks, so both the scrolled previous ones and the current ones
+     * have to be redrawn */
+    static void markMissilesDirty(Context& ctx, const uint64_t* previousMissiles, int16_t fieldLeft, uint8_t scrollDelta) {
+        for (size_t row = 0; row < NUM_ROWS; row++) {
+            const int16_t drawY = GAMEBOARD_Y + row * BLOCK_HEIGHT;
+            uint64_t missiles = previousMissiles[row] | getMissileMask(ctx, row);
+            for (size_t col = 0; missiles; col++, missiles >>= 1) {
+                if (missiles & 0x01) {
+                    int16_t missileX = PLAYER_WIDTH + (col + 1) * BLOCK_WIDTH + 1;
+                    markDirtyAt(ctx, fieldLeft, missileX, drawY);
+                    markDirtyAt(ctx, fieldLeft, missileX - scrollDelta, drawY);
+                }
             }
         }
     }
 
-    GameState run(Context& ctx, Image& tileset) {
+    /* Moves the field band of the framebuffer left by the given number of pixels, like the blocks have moved.
+     * The rightmost scrollDelta pixels of each line are left undefined. */
+    static void scrollFieldBand(uint8_t scrollDelta) {
+        const size_t LINE_BYTES = SCREEN_WIDTH / 2;
+        const size_t skip = scrollDelta >> 1;
+        uint8_t* line = raster::framebuffer() + GAMEBOARD_Y * LINE_BYTES;
+
+        for (size_t y = GAMEBOARD_Y; y < (size_t)FIELD_BOTTOM; y++) {
+            if (scrollDelta & 0x01) {
+                /* Shift by a nibble, 8 pixels at a time. The leftmost pixel is in the upper nibble of the
+                 * first byte, so the words are handled in big endian order. */
+                size_t ix = 0;
+                for (; ix + skip + 8 <= LINE_BYTES; ix += 4) {
+                    uint32_t w0, w1;
+                    memcpy(&w0, line + ix + skip, 4);
+                    memcpy(&w1, line + ix + skip + 4, 4);
+                    w0 = __builtin_bswap32((__builtin_bswap32(w0) << 4) | (__builtin_bswap32(w1) >> 28));
+                    memcpy(line + ix, &w0, 4);
+                }
+                for (; ix + skip + 1 < LINE_BYTES; ix++) {
+                    line[ix] = (line[ix + skip] << 4) | (line[ix + skip + 1] >> 4);
+                }
+                line[ix] = line[ix + skip] << 4;
+            } else {
+                memmove(line, line + skip, LINE_BYTES - skip);
+            }
+            line += LINE_BYTES;
+        }
+    }
+
+    /* Marks the cells uncovered on the right side of the screen by scrollFieldBand() */
+    static void markExposedCells(Context& ctx, int16_t fieldLeft, uint8_t scrollDelta) {
+        size_t firstCol = (SCREEN_WIDTH - scrollDelta - fieldLeft) / BLOCK_WIDTH;
+        uint64_t mask = ~((static_cast<uint64_t>(1) << firstCol) - 1);
+        for (size_t row = 0; row < NUM_ROWS; row++) {
+            ctx.dirtyCells[row] |= mask;
+        }
+    }
+
+    /* Redraws only what has changed since the previous frame: the HUD bars, the ship column and the dirty cells.
+     * Must produce the same pixels as the full repaint, so after a scroll the framebuffer has to be moved
+     * with scrollFieldBand() and the cells of everything that does not move with the blocks marked first. */
+    static void drawFrameIncremental(Context& ctx, uint8_t spriteDx, bool stripMoved) {
+        const int16_t fieldLeft = PLAYER_WIDTH + BLOCK_WIDTH - spriteDx;
+        uint8_t* buffer = raster::framebuffer();
+
+        /* The strip left of the field only holds the sprites, the particles and the stars */
+        if (stripMoved) {
+            clearRect(0, GAMEBOARD_Y, fieldLeft, FIELD_BOTTOM - GAMEBOARD_Y);
+        } else {
+            eraseSprites(ctx, fieldLeft);
+        }
+
+        for (size_t row = 0; row < NUM_ROWS; row++) {
+            uint64_t dirty = ctx.dirtyCells[row];
+            for (size_t col = 0; dirty; col++, dirty >>= 1) {
+                if (dirty & 0x01) {
+                    clearRect(fieldLeft + col * BLOCK_WIDTH, GAMEBOARD_Y + row * BLOCK_HEIGHT, BLOCK_WIDTH, BLOCK_HEIGHT);
+                }
+            }
+        }
+
+        if (ctx.flags & FLAG_SHOW_BACKGROUND) {
+            starfield::draw(buffer, gb.frameCount, ctx.dirtyCells, fieldLeft);
+        }
+        drawBorders(ctx);
+
+        for (size_t row = 0; row < NUM_ROWS; row++) {
+            uint64_t dirty = ctx.dirtyCells[row];
+            const int16_t drawY = GAMEBOARD_Y + row * BLOCK_HEIGHT;
+
+            for (size_t col = 0; dirty && col < NUM_COLS; col++, dirty >>= 1) {
+                if (!(dirty & 0x01)) {
+                    continue;
+                }
+                const int16_t cellX = fieldLeft + col * BLOCK_WIDTH;
+                if (cellX >= (int16_t)SCREEN_WIDTH) {
+                    break;
+                }
+
+                auto blk = getBlock(ctx, row, col);
+                if (blk != ElementID::None) {
+                    tileset::draw(cellX, drawY, blk);
+                }
+
+                /* Missile lines do not follow smooth scrolling, so the one of the previous cell may land here */
+                drawMissileInCell(ctx, row, col, cellX, drawY);
+                if (col > 0) {
+                    drawMissileInCell(ctx, row, col - 1, cellX, drawY);
+                }
+            }
+        }
+    }
+
+    GameState run(Context& ctx, FrameHook frameHook) {
         Color barsPalettes[16][8];
         Color tilesPalette[16];
         tileset::ElementID playerTiles[4];
-        uint16_t background[64];
 
         if (ctx.flags & FLAG_SHOW_BACKGROUND) {
-            for (uint8_t ix = 0; ix < sizeof(background) / sizeof(background[0]); ix++) {
-                uint8_t x = rand() & 0xFF; // mod 256
-                uint8_t y = rand() & 0x3F; // mod 64
-                uint8_t c = rand() & 0x03; // mod 4
-                const uint8_t max_y = NUM_ROWS * BLOCK_HEIGHT / 2;
-                if (y > max_y) {
-                    y -= max_y;
-                }
-                background[ix] = (c << 14) | (y << 8) | x;
-            }
+            starfield::init();
         }
 
         memcpy(tilesPalette, tileset::palette, sizeof(tilesPalette));
 
         initColorCells(barsPalettes, tilesPalette);
+        effects::begin(reinterpret_cast<const uint16_t*>(tilesPalette));
         initPlayerTiles(playerTiles);
+        particles::reset();
+        initPlayerSprites();
+        initHud();
         
       DrawScene drawScene = DrawScene::Gameplay;
 
       uint8_t drawSceneCounter = 0;
 
+      /* State of the framebuffer, as left by the previous frame */
+      bool previousFrameValid = false;
+      uint8_t previousSpriteDx = 0;
+      uint32_t previousFrame = 0;
+      uint64_t previousMissiles[NUM_ROWS];
+
       while (1) {
         processEvents();
 
+        if (frameHook && !frameHook(ctx)) {
+            striprenderer::end();
+            lowresrenderer::end();
+            effects::end();
+            return GameState::Aborted;
+        }
+
         switch (updateGameField(ctx, drawScene)) {
             case GameState::Continue:
+            case GameState::Aborted:
                 break;
 
             case GameState::GameOverTimeout:
@@ -598,6 +904,13 @@ using ElementID = tileset::ElementID;
                 break;
         }
 
+        /* Before drawing, the strip renderer converts the lines as it goes */
+        if (drawScene == DrawScene::Gameplay) {
+            effects::update(ctx.bonusRows);
+        } else {
+            effects::end();
+        }
+
 
         size_t drawY = GAMEBOARD_Y;
         const size_t WARNING_X = NUM_COLS / 2 + 5;
@@ -613,6 +926,7 @@ using ElementID = tileset::ElementID;
                     gb.sound.tone(622, 800);
                     playerTiles[PLAYER_TILE_TAIL] = tileset::ElementID::ShipTailExploding;
                     playerTiles[PLAYER_TILE_FRONT] = tileset::ElementID::ShipFrontExploding;
+                    particles::spawnShipExplosion(shipX + PLAYER_WIDTH / 2, GAMEBOARD_Y + ctx.playerPosition * PLAYER_HEIGHT + PLAYER_HEIGHT / 2);
                 } else if (drawSceneCounter == 16) {
                     paletteSyncFadeToBlack(0, 8, 12);
                     return GameState::GameOverLost;
@@ -632,14 +946,82 @@ using ElementID = tileset::ElementID;
             }
         }
 
-        /* Fast screen clear */
-        memset(gb.display._buffer, 0, SCREEN_WIDTH * SCREEN_HEIGHT / 2);
-        drawBorders(ctx);
-        if (ctx.flags & FLAG_SHOW_BACKGROUND) {
-            drawBackground(background);
+        updatePlayerSprites(shipX, ctx.playerPosition, playerTiles);
+
+        /* The endgame scenes fade the palettes out, which needs the picture to stay in the framebuffer */
+        const bool useStrips = ctx.renderMode == RenderMode::Strips && drawScene == DrawScene::Gameplay;
+        const bool useLowRes = ctx.renderMode == RenderMode::LowResolution && drawScene == DrawScene::Gameplay;
+        if (!useStrips) {
+            striprenderer::end();
+        }
+        if (!useLowRes) {
+            lowresrenderer::end();
+        }
+
+        if (useLowRes) {
+            lowresrenderer::begin();
+            updateHud(ctx);
+            lowresrenderer::drawFrame(ctx, getSpriteDx(ctx));
+            updateAnimation(playerTiles, 4);
+            particles::updateAndDraw(lowresrenderer::plotPixel);
+            previousFrameValid = false;
+        } else if (useStrips) {
+            striprenderer::begin();
+            buildDisplayList(ctx);
+            updateAnimation(playerTiles, 4);
+            particles::updateAndDraw(displaylist::addPixel);
+            striprenderer::drawFrame();
+            previousFrameValid = false;
+        } else if (ctx.renderMode != RenderMode::Incremental) {
+            buildDisplayList(ctx);
+            displaylist::rasterize(raster::framebuffer());
+            updateAnimation(playerTiles, 4);
+            particles::updateAndDraw();
+            previousFrameValid = false;
+        } else {
+            uint8_t spriteDx = getSpriteDx(ctx);
+            const bool starsMoved = (ctx.flags & FLAG_SHOW_BACKGROUND) && starfield::moved(gb.frameCount, previousFrame);
+            /* How many pixels left the blocks have moved since the previous frame */
+            int16_t scrollDelta = (ctx.scrolled ? BLOCK_WIDTH : 0) + spriteDx - previousSpriteDx;
+            bool fullRepaint = !previousFrameValid || ctx.fullRepaint || drawScene != DrawScene::Gameplay
+                    || scrollDelta < 0 || scrollDelta > (int16_t)BLOCK_WIDTH;
+
+            if (fullRepaint) {
+                raster::fillRect(raster::framebuffer(), 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 0);
+                hud::invalidate();
+                drawBorders(ctx);
+                if (ctx.flags & FLAG_SHOW_BACKGROUND) {
+                    starfield::draw(raster::framebuffer(), gb.frameCount);
+                }
+                drawGameField(ctx);
+            } else {
+                const int16_t fieldLeft = PLAYER_WIDTH + BLOCK_WIDTH - spriteDx;
+                if (scrollDelta > 0) {
+                    scrollFieldBand(scrollDelta);
+                    markExposedCells(ctx, fieldLeft, scrollDelta);
+                    markMissilesDirty(ctx, previousMissiles, fieldLeft, scrollDelta);
+                }
+                if ((ctx.flags & FLAG_SHOW_BACKGROUND) && (scrollDelta > 0 || starsMoved)) {
+                    markStarsDirty(ctx, fieldLeft, scrollDelta, previousFrame);
+                }
+                eraseParticles(ctx, fieldLeft, scrollDelta);
+                drawFrameIncremental(ctx, spriteDx, scrollDelta > 0 || starsMoved);
+            }
+
+            previousFrameValid = drawScene == DrawScene::Gameplay;
+            previousSpriteDx = spriteDx;
+            previousFrame = gb.frameCount;
+            for (size_t row = 0; row < NUM_ROWS; row++) {
+                previousMissiles[row] = getMissileMask(ctx, row);
+            }
+            ctx.fullRepaint = false;
+            memset(ctx.dirtyCells, 0, sizeof(ctx.dirtyCells));
+
+            sprites::draw();
+            updateAnimation(playerTiles, 4);
+            particles::updateAndDraw();
         }
-        drawGameField(ctx, tileset);
-        drawPlayer(shipX, ctx.playerPosition, playerTiles, tileset);
+        ctx.scrolled = false;
 
         switch (drawScene) {
         case DrawScene::Gameplay:
@@ -656,4 +1038,36 @@ using ElementID = tileset::ElementID;
       }
     }
 
+    void beginDrawSteps() {
+        initHud();
+        initPlayerSprites();
+        starfield::init();
+    }
+
+    void drawStep(Context& ctx, DrawStep step) {
+        switch (step) {
+            case DrawStep::GameField:
+                drawGameField(ctx);
+                break;
+
+            case DrawStep::Player: {
+                tileset::ElementID playerTiles[4];
+                initPlayerTiles(playerTiles);
+                updatePlayerSprites(0, ctx.playerPosition, playerTiles);
+                sprites::draw();
+                break;
+            }
+
+            case DrawStep::Background:
+                starfield::draw(raster::framebuffer(), gb.frameCount);
+                break;
+
+            /* The whole HUD, as after a full repaint */
+            case DrawStep::Borders:
+                hud::invalidate();
+                drawBorders(ctx);
+                break;
+        }
+    }
+
 }}} // namespace spaceshoot::context::game
@@ -29,9 +29,18 @@
 
 namespace spaceshoot { namespace context { namespace game {
 
+    enum struct RenderMode: uint8_t {
+        Incremental, Scanline, Strips,
+        /* The low resolution profile, with its own renderer */
+        LowResolution,
+
+        Count
+    };
+
     struct Context {
         uint8_t difficultyLevel;
         uint8_t flags;
+        RenderMode renderMode;
 
         uint8_t playerPosition;
         uint32_t score;
@@ -47,15 +56,28 @@ namespace spaceshoot { namespace context { namespace game {
         uint16_t blocksPresent;
         uint8_t gameField[NUM_ROWS][NUM_COLS];
 
+        /* One bit per column, set whenever the block, missile or animation frame of a cell changes */
+        uint64_t dirtyCells[NUM_ROWS];
+        /* Forces the next frame to be drawn from scratch */
+        bool fullRepaint;
+        /* Set when the blocks have moved one column left (scroll step) */
+        bool scrolled;
+        /* One bit per row holding a bonus, as of the last update of the game field */
+        uint32_t bonusRows;
+
         Context() = default;
         Context(const Context&) = delete;
         Context& operator=(const Context&) = delete;
     };
 
     enum struct GameState {
-      Continue, GameOverTimeout, GameOverLost
+      Continue, GameOverTimeout, GameOverLost, Aborted
     };
 
+    /* Called at the beginning of every frame, before the game field is updated.
+     * Returning false makes run() return GameState::Aborted. */
+    using FrameHook = bool (*)(Context& ctx);
+
     const uint8_t BLOCK_MASK = 0x3F;
     const uint8_t BLOCK_MISSILE = 0x40;
     const uint8_t FLAG_SMOOTH_SCROLLING = 0x01;
@@ -63,12 +85,43 @@ namespace spaceshoot { namespace context { namespace game {
     const uint8_t FLAG_SHOW_BACKGROUND = 0x04;
 
     void restart(Context& ctx);
-    GameState run(Context& ctx, Image& tileset);
+    GameState run(Context& ctx, FrameHook frameHook = nullptr);
+
+    /* Single drawing steps of the incremental renderer, for the microbenchmarks. beginDrawSteps() sets up
+     * the HUD, the player sprites and the stars the way run() does. */
+    enum struct DrawStep : uint8_t {
+        GameField, Player, Background, Borders
+    };
+
+    void beginDrawSteps();
+    void drawStep(Context& ctx, DrawStep step);
+
+    static_assert(NUM_COLS < 64);
+
+    static inline void markDirty(Context& ctx, uint8_t row, uint8_t col) {
+        ctx.dirtyCells[row] |= static_cast<uint64_t>(1) << col;
+    }
+
+    static inline void updateCell(Context& ctx, uint8_t row, uint8_t col, uint8_t value) {
+        uint8_t previous = ctx.gameField[row][col];
+        if (value != previous) {
+            ctx.gameField[row][col] = value;
+            markDirty(ctx, row, col);
+            /* With smooth scrolling, the missile may be drawn over the next cell */
+            if ((value ^ previous) & BLOCK_MISSILE) {
+                markDirty(ctx, row, col + 1);
+            }
+        }
+    }
 
     static inline tileset::ElementID getBlock(Context& ctx, uint8_t row, uint8_t col) {
         return static_cast<tileset::ElementID>(ctx.gameField[row][col] & BLOCK_MASK);
     }
 
+    static inline bool isBonusBlock(tileset::ElementID elementID) {
+        return elementID >= tileset::ElementID::Bonus1 && elementID <= tileset::ElementID::Bonus4;
+    }
+
     static inline bool isFunctionBlock(tileset::ElementID elementID) {
         if (elementID >= tileset::ElementID::Bomb1 && elementID <= tileset::ElementID::Bomb4) {
             return true;
@@ -80,12 +133,11 @@ namespace spaceshoot { namespace context { namespace game {
     }
 
     static inline void setBlock(Context& ctx, uint8_t row, uint8_t col, tileset::ElementID elementID) {
-        ctx.gameField[row][col] &= ~BLOCK_MASK;
-        ctx.gameField[row][col] |= static_cast<uint8_t>(elementID);
+        updateCell(ctx, row, col, (ctx.gameField[row][col] & ~BLOCK_MASK) | static_cast<uint8_t>(elementID));
     }
 
     static inline void setBlockClearMissile(Context& ctx, uint8_t row, uint8_t col, tileset::ElementID elementID) {
-        ctx.gameField[row][col] = static_cast<uint8_t>(elementID);
+        updateCell(ctx, row, col, static_cast<uint8_t>(elementID));
     }
 
     static inline bool getMissile(Context& ctx, uint8_t row, uint8_t col) {
@@ -94,9 +146,9 @@ namespace spaceshoot { namespace context { namespace game {
 
     static inline void setMissile(Context& ctx, uint8_t row, uint8_t col, bool present) {
         if (present) {
-            ctx.gameField[row][col] |= BLOCK_MISSILE;
+            updateCell(ctx, row, col, ctx.gameField[row][col] | BLOCK_MISSILE);
         } else {
-            ctx.gameField[row][col] &= ~BLOCK_MISSILE;
+            updateCell(ctx, row, col, ctx.gameField[row][col] & ~BLOCK_MISSILE);
         }
     }
 
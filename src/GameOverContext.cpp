@@ -23,11 +23,39 @@
 #include "GameOverContext.h"
 #include "GameContext.h"
 #include "Utils.h"
-#include "utility/Graphics/font3x5.c"
-#include "font4x7.c"
+#include "Raster.h"
+#include "Text.h"
 
 namespace spaceshoot { namespace context { namespace gameover {
 
+    const int16_t DISPLAY_X = SCREEN_WIDTH - 2 * 4 * 5 - 8;
+    const int16_t DISPLAY_X1 = DISPLAY_X - 6 * 5 - 8;
+
+    const int16_t SCORE_Y = 44;
+    const int16_t ACCURACY_Y = 56;
+    const int16_t BONUS_Y = 68;
+    /* End of the three rows above, they are cleared at once when only the final score remains */
+    const int16_t STATS_BOTTOM_Y = 78;
+
+    /* The final score slides from FINAL_SCORE_Y up to FINAL_SCORE_TOP_Y */
+    const int16_t FINAL_SCORE_Y = 100;
+    const int16_t FINAL_SCORE_TOP_Y = 20;
+
+    /* The 2x2 digits, the labels next to them are shorter */
+    const int16_t COUNTER_HEIGHT = 10;
+
+    const uint8_t COLOR_BACKGROUND = 0;
+
+    /* What has been drawn so far */
+    struct StatsScreen {
+        int32_t phase;          /* -1 before the first frame */
+        uint32_t score;
+        uint32_t accuracyPoints;
+        uint32_t bonus;
+        uint32_t totalScore;
+        int16_t totalScoreY;
+    };
+
     static bool decreaseByInterval(uint32_t& measure, uint32_t interval, uint32_t& score) {
         if (measure >= interval) {
             measure -= interval;
@@ -37,78 +65,124 @@ namespace spaceshoot { namespace context { namespace gameover {
         return false;
     }
 
-    static void drawStats(uint32_t score, uint16_t accuracy, uint32_t accuracyPoints, uint32_t bonus, uint32_t totalScore, uint16_t showPhase, game::Context& ctx) {
-      const unsigned int DISPLAY_X = SCREEN_WIDTH - 2 * 4 * 5 - 8;
-      const unsigned int DISPLAY_X1 = DISPLAY_X - 6 * 5 - 8;
+    static bool reached(const StatsScreen& screen, uint32_t showPhase, int32_t phase) {
+        return (int32_t)showPhase >= phase && screen.phase < phase;
+    }
 
-      uint32_t totalScoreY = 100;
-        if (showPhase > 64) {
-            if (showPhase < 104) {
-                totalScoreY -= (showPhase - 64) * 2;
-            } else {
-                totalScoreY -= (104 - 64) * 2;
+    static void drawLabel(int16_t x, int16_t y, ColorIndex color, const char* str) {
+        text::setFormat(color, 1, 1, text::FONT_4X7);
+        text::print(x, y, str);
+    }
+
+    /* Repaints a 2x2 counter together with its background */
+    static void drawCounter(int16_t y, ColorIndex color, uint32_t value) {
+        raster::fillRect(raster::framebuffer(), DISPLAY_X, y, SCREEN_WIDTH - DISPLAY_X, COUNTER_HEIGHT, COLOR_BACKGROUND);
+        text::setFormat(color, 2, 2, text::FONT_3X5);
+        text::printf(DISPLAY_X, y, "%5d", value);
+    }
+
+    static void updateCounter(uint32_t& shown, int16_t y, ColorIndex color, uint32_t value) {
+        if (shown != value) {
+            drawCounter(y, color, value);
+            shown = value;
+        }
+    }
+
+    /* Draws the blocks as they appear and repaints the counters that have changed since the previous frame */
+    static void updateStats(StatsScreen& screen, uint32_t score, uint16_t accuracy, uint32_t accuracyPoints, uint32_t bonus, uint32_t totalScore, uint32_t showPhase, game::Context& ctx) {
+        uint8_t* buffer = raster::framebuffer();
+
+        int16_t totalScoreY = FINAL_SCORE_Y;
+        if (showPhase >= 104) {
+            totalScoreY = FINAL_SCORE_TOP_Y;
+        } else if (showPhase > 64) {
+            totalScoreY -= (showPhase - 64) * 2;
+        }
+
+        if (reached(screen, showPhase, 0)) {
+            drawLabel(4, SCORE_Y, INDEX_GRAY, "SCORE");
+            drawCounter(SCORE_Y, INDEX_LIGHTGREEN, score);
+            screen.score = score;
+        }
+        if (reached(screen, showPhase, 16)) {
+            drawLabel(4, ACCURACY_Y, INDEX_GRAY, "ACCURACY");
+
+            text::setFormat(INDEX_RED, 1, 2, text::FONT_3X5);
+            text::printf(DISPLAY_X1, ACCURACY_Y, "%3d.%1d%%", accuracy / 10, accuracy % 10);
+
+            drawCounter(ACCURACY_Y, INDEX_LIGHTGREEN, accuracyPoints);
+            screen.accuracyPoints = accuracyPoints;
+        }
+        if (reached(screen, showPhase, 32)) {
+            drawLabel(4, BONUS_Y, INDEX_GRAY, "BONUS");
+            drawCounter(BONUS_Y, INDEX_LIGHTGREEN, bonus);
+            screen.bonus = bonus;
+        }
+        if (reached(screen, showPhase, 48)) {
+            drawLabel(4, totalScoreY, INDEX_BEIGE, "FINAL SCORE");
+            drawCounter(totalScoreY, INDEX_YELLOW, totalScore);
+            screen.totalScore = totalScore;
+            screen.totalScoreY = totalScoreY;
+        }
+
+        if (showPhase < 80) {
+            updateCounter(screen.score, SCORE_Y, INDEX_LIGHTGREEN, score);
+            if (showPhase >= 16) updateCounter(screen.accuracyPoints, ACCURACY_Y, INDEX_LIGHTGREEN, accuracyPoints);
+            if (showPhase >= 32) updateCounter(screen.bonus, BONUS_Y, INDEX_LIGHTGREEN, bonus);
+        }
+
+        if (showPhase >= 48) {
+            /* The block slides up over whatever is above it, the lines it leaves are cleared */
+            if (totalScoreY != screen.totalScoreY) {
+                raster::moveLines(buffer, totalScoreY, screen.totalScoreY, COUNTER_HEIGHT);
+                raster::fillRect(buffer, 0, totalScoreY + COUNTER_HEIGHT, SCREEN_WIDTH,
+                        screen.totalScoreY - totalScoreY, COLOR_BACKGROUND);
+                screen.totalScoreY = totalScoreY;
+            }
+            updateCounter(screen.totalScore, totalScoreY, INDEX_YELLOW, totalScore);
+        }
+
+        if (reached(screen, showPhase, 80)) {
+            /* Everything but the final score block, wherever it is by now */
+            if (totalScoreY > SCORE_Y) {
+                raster::fillRect(buffer, 0, SCORE_Y, SCREEN_WIDTH, totalScoreY - SCORE_Y, COLOR_BACKGROUND);
+            }
+            if (totalScoreY + COUNTER_HEIGHT < STATS_BOTTOM_Y) {
+                raster::fillRect(buffer, 0, totalScoreY + COUNTER_HEIGHT, SCREEN_WIDTH,
+                        STATS_BOTTOM_Y - totalScoreY - COUNTER_HEIGHT, COLOR_BACKGROUND);
             }
         }
-      
-      gb.display.setColor(INDEX_LIGHTGREEN);
-      if (showPhase >= 0 && showPhase < 80) {
-          setTextFormat(INDEX_GRAY, 1, 1, font4x7);
-          gb.display.printf(4, 44, "SCORE");
-
-          setTextFormat(INDEX_LIGHTGREEN, 2, 2, font3x5);
-          gb.display.printf(DISPLAY_X, 44, "%5d", score);
-      }
-      if (showPhase >= 16 && showPhase < 80) {
-          setTextFormat(INDEX_GRAY, 1, 1, font4x7);
-          gb.display.printf(4, 56, "ACCURACY");
-
-          setTextFormat(INDEX_RED, 1, 2, font3x5);
-          gb.display.printf(DISPLAY_X1, 56, "%3d.%1d%%", accuracy / 10, accuracy % 10);
-
-          setTextFormat(INDEX_LIGHTGREEN, 2, 2, font3x5);
-          gb.display.printf(DISPLAY_X, 56, "%5d", accuracyPoints);
-      }
-      if (showPhase >= 32 && showPhase < 80) {
-          setTextFormat(INDEX_GRAY, 1, 1, font4x7);
-          gb.display.printf(4, 68, "BONUS");
-
-          setTextFormat(INDEX_LIGHTGREEN, 2, 2, font3x5);
-          gb.display.printf(DISPLAY_X, 68, "%5d", bonus);
-      }
-      if (showPhase >= 48) {
-        setTextFormat(INDEX_BEIGE, 1, 1, font4x7);
-        gb.display.printf(4, totalScoreY, "FINAL SCORE");
-
-        setTextFormat(INDEX_YELLOW, 2, 2, font3x5);
-        gb.display.printf(DISPLAY_X, totalScoreY, "%5d", totalScore);
-      }
-
-      gb.display.setFontSize(1, 1);
-      if (showPhase >= 100) {
-          gb.display.setColor(INDEX_GREEN);
-          gb.display.printf(80, 48, "HIT");
-          gb.display.setColor(INDEX_RED);
-          gb.display.printf(116, 48, "MISS");
-
-          gb.display.setColor(INDEX_GRAY);
-          gb.display.printf(4, 56, "BOMB BLOCKS");
-          gb.display.printf(4, 64, "BONUS BLOCKS");
-
-          gb.display.setColor(INDEX_LIGHTGREEN);
-          gb.display.setFontSize(2, 1);
-          gb.display.printf(76, 56,  "%4d", ctx.bombsCollected);
-          gb.display.printf(76, 64, "%4d", ctx.bonusBlocksCollected);
-          gb.display.setColor(INDEX_ORANGE);
-          gb.display.setFontSize(2, 1);
-          gb.display.printf(116, 56,  "%4d", ctx.bombsMissed);
-          gb.display.printf(116, 64, "%4d", ctx.bonusBlocksMissed);
-
-          gb.display.setColor(INDEX_WHITE);
-          gb.display.setFontSize(1, 1);
-          gb.display.setFont(font4x7);
-          gb.display.print(8, 112, "Press \x01\x08 to play again");
-          gb.display.print(8, 120, "Press \x02\x09 to return to main menu");
-      }
+
+        if (reached(screen, showPhase, 100)) {
+            text::setFontSize(1, 1);
+            text::setColor(INDEX_GREEN);
+            text::printf(80, 48, "HIT");
+            text::setColor(INDEX_RED);
+            text::printf(116, 48, "MISS");
+
+            text::setColor(INDEX_GRAY);
+            text::printf(4, 56, "BOMB BLOCKS");
+            text::printf(4, 64, "BONUS BLOCKS");
+
+            text::setColor(INDEX_LIGHTGREEN);
+            text::setFontSize(2, 1);
+            text::printf(76, 56,  "%4d", ctx.bombsCollected);
+            text::printf(76, 64, "%4d", ctx.bonusBlocksCollected);
+            text::setColor(INDEX_ORANGE);
+            text::setFontSize(2, 1);
+            text::printf(116, 56,  "%4d", ctx.bombsMissed);
+            text::printf(116, 64, "%4d", ctx.bonusBlocksMissed);
+
+            text::setColor(INDEX_WHITE);
+            text::setFontSize(1, 1);
+            text::setFont(text::FONT_4X7);
+            text::print(8, 112, "Press \x01\x08 to play again");
+            text::print(8, 120, "Press \x02\x09 to return to main menu");
+        }
+
+        if ((int32_t)showPhase > screen.phase) {
+            screen.phase = showPhase;
+        }
     }
 
     bool run(game::Context& ctx, bool timedOut) {
@@ -117,7 +191,6 @@ namespace spaceshoot { namespace context { namespace gameover {
         uint32_t bonus;
         uint32_t gameScore = ctx.score;
         uint32_t showPhaseCounter = 0;
-        uint32_t showPhase = 0;
 
         uint16_t pal[16];
         memcpy(pal, Gamebuino_Meta::defaultColorPalette, sizeof(pal));
@@ -142,8 +215,11 @@ namespace spaceshoot { namespace context { namespace gameover {
 
         ctx.score = 0;
 
+        StatsScreen screen = {};
+        screen.phase = -1;
+        gb.display.clear();
+
         while (1) {
-            gb.display.clear();
 
             if (showPhaseCounter == 64) {
                 bool updated = decreaseByInterval(gameScore, 1000, ctx.score);
@@ -167,7 +243,7 @@ namespace spaceshoot { namespace context { namespace gameover {
                 showPhaseCounter++;
             }
 
-            drawStats(gameScore, accuracy, accuracyPoints, bonus, ctx.score, showPhaseCounter, ctx);
+            updateStats(screen, gameScore, accuracy, accuracyPoints, bonus, ctx.score, showPhaseCounter, ctx);
 
             processEvents();
 
@@ -0,0 +1,212 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#include "Hud.h"
+#include "Raster.h"
+#include <string.h>
+
+namespace spaceshoot { namespace hud {
+
+    const uint8_t FONT_WIDTH = 3;
+    const uint8_t FONT_HEIGHT = 5;
+    const size_t NUM_GLYPHS = sizeof(CHARSET) - 1;
+
+    /* A character cell is the glyph with the spacing right of it, (FONT_WIDTH + 1) * scale pixels wide. Every
+     * pixel of the glyph is a 0xF nibble, the color is applied with AND. */
+    const uint8_t SMALL_CELL_BYTES = (FONT_WIDTH + 1) / 2;
+    const uint8_t LARGE_CELL_BYTES = FONT_WIDTH + 1;
+
+    static uint8_t smallGlyphs[NUM_GLYPHS][FONT_HEIGHT][SMALL_CELL_BYTES];
+    static uint8_t largeGlyphs[LARGE_GLYPHS][FONT_HEIGHT][LARGE_CELL_BYTES];
+    /* Glyph index of every character from FIRST_CHAR on, 0 (space) for the ones not in the charset */
+    const uint8_t FIRST_CHAR = ' ';
+    static uint8_t glyphIndex['Z' - FIRST_CHAR + 1];
+
+    struct Field {
+        int16_t x;
+        uint8_t y;
+        uint8_t scale;
+        uint8_t color;      /* Replicated into both nibbles */
+        uint8_t length;     /* Zero for an unused field */
+        uint8_t offset;     /* In the text pools */
+    };
+
+    static Field fields[MAX_FIELDS];
+    static uint8_t poolUsed;
+    /* Glyph indices to show and the ones drawn by the last draw() */
+    static uint8_t text[TEXT_POOL_SIZE];
+    static uint8_t shown[TEXT_POOL_SIZE];
+
+    const uint8_t NOT_SHOWN = 0xFF;
+
+    static_assert(NUM_GLYPHS < NOT_SHOWN);
+    static_assert(LARGE_GLYPHS <= NUM_GLYPHS);
+
+    static void renderGlyph(uint8_t* dest, const uint8_t* font, char c, uint8_t scale) {
+        const uint8_t* columns = font + 2 + c * font[0];
+        const uint8_t cellBytes = (FONT_WIDTH + 1) * scale / 2;
+
+        for (uint8_t row = 0; row < FONT_HEIGHT; row++) {
+            for (uint8_t bx = 0; bx < cellBytes; bx++) {
+                uint8_t value = 0;
+                for (uint8_t half = 0; half < 2; half++) {
+                    uint8_t column = (bx * 2 + half) / scale;
+                    if (column < FONT_WIDTH && (columns[column] & (1 << row))) {
+                        value |= half ? 0x0F : 0xF0;
+                    }
+                }
+                *dest++ = value;
+            }
+        }
+    }
+
+    void init(const uint8_t* font) {
+        memset(glyphIndex, 0, sizeof(glyphIndex));
+        for (uint8_t ix = 0; ix < NUM_GLYPHS; ix++) {
+            glyphIndex[CHARSET[ix] - FIRST_CHAR] = ix;
+            renderGlyph(&smallGlyphs[ix][0][0], font, CHARSET[ix], 1);
+            if (ix < LARGE_GLYPHS) {
+                renderGlyph(&largeGlyphs[ix][0][0], font, CHARSET[ix], 2);
+            }
+        }
+        /* The space is also the padding and the stand-in for unknown characters, so it has to be blank */
+        memset(smallGlyphs[0], 0, sizeof(smallGlyphs[0]));
+        memset(largeGlyphs[0], 0, sizeof(largeGlyphs[0]));
+
+        memset(fields, 0, sizeof(fields));
+        poolUsed = 0;
+    }
+
+    void setField(uint8_t index, int16_t x, uint8_t y, uint8_t scale, uint8_t color, uint8_t length) {
+        Field& field = fields[index];
+        if (field.length == 0) {
+            if (poolUsed + length > TEXT_POOL_SIZE) {
+                return;
+            }
+            field.offset = poolUsed;
+            poolUsed += length;
+        } else if (length > field.length) {
+            length = field.length;
+        }
+
+        field.x = x;
+        field.y = y;
+        field.scale = scale;
+        field.color = color * 0x11;
+        field.length = length;
+        memset(text + field.offset, 0, length);
+        memset(shown + field.offset, NOT_SHOWN, length);
+    }
+
+    void setText(uint8_t index, const char* str) {
+        const Field& field = fields[index];
+        uint8_t* dest = text + field.offset;
+        for (uint8_t ix = 0; ix < field.length; ix++) {
+            uint8_t c = *str;
+            if (c) {
+                str++;
+            }
+            uint8_t glyph = (c >= FIRST_CHAR && (size_t)(c - FIRST_CHAR) < sizeof(glyphIndex)) ? glyphIndex[c - FIRST_CHAR] : 0;
+            dest[ix] = (field.scale > 1 && glyph >= LARGE_GLYPHS) ? 0 : glyph;
+        }
+    }
+
+    void invalidate() {
+        memset(shown, NOT_SHOWN, sizeof(shown));
+    }
+
+    static inline const uint8_t* glyphRow(const Field& field, uint8_t glyph, uint8_t row) {
+        return field.scale > 1 ? largeGlyphs[glyph][row] : smallGlyphs[glyph][row];
+    }
+
+    static inline void drawCellRow(uint8_t* dest, const uint8_t* glyph, uint8_t bytes, uint8_t color) {
+        for (uint8_t bx = 0; bx < bytes; bx++) {
+            dest[bx] = glyph[bx] & color;
+        }
+    }
+
+    void draw(uint8_t* buffer) {
+        for (size_t fx = 0; fx < MAX_FIELDS; fx++) {
+            const Field& field = fields[fx];
+            const uint8_t cellBytes = (FONT_WIDTH + 1) * field.scale / 2;
+            uint8_t* cell = buffer + field.y * raster::LINE_BYTES + field.x / 2;
+
+            for (uint8_t ix = 0; ix < field.length; ix++, cell += cellBytes) {
+                uint8_t glyph = text[field.offset + ix];
+                if (shown[field.offset + ix] == glyph) {
+                    continue;
+                }
+                shown[field.offset + ix] = glyph;
+                for (uint8_t row = 0; row < FONT_HEIGHT; row++) {
+                    drawCellRow(cell + row * raster::LINE_BYTES, glyphRow(field, glyph, row), cellBytes, field.color);
+                }
+            }
+        }
+    }
+
+    void drawRow(uint8_t* line, uint8_t y) {
+        for (size_t fx = 0; fx < MAX_FIELDS; fx++) {
+            const Field& field = fields[fx];
+            if (field.length == 0 || y < field.y || y >= field.y + FONT_HEIGHT) {
+                continue;
+            }
+
+            const uint8_t row = y - field.y;
+            const uint8_t cellBytes = (FONT_WIDTH + 1) * field.scale / 2;
+            uint8_t* cell = line + field.x / 2;
+            for (uint8_t ix = 0; ix < field.length; ix++, cell += cellBytes) {
+                drawCellRow(cell, glyphRow(field, text[field.offset + ix], row), cellBytes, field.color);
+            }
+        }
+    }
+
+    static const uint32_t POWERS_OF_TEN[] = {
+        1000000000, 100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1
+    };
+    const uint8_t MAX_DIGITS = sizeof(POWERS_OF_TEN) / sizeof(POWERS_OF_TEN[0]);
+
+    uint8_t formatNumber(char* dest, uint32_t value, uint8_t width) {
+        uint8_t length = 0;
+        bool leading = true;
+
+        for (uint8_t ix = 0; ix < MAX_DIGITS; ix++) {
+            /* Each digit by repeated subtraction, at most 9 of them */
+            const uint32_t power = POWERS_OF_TEN[ix];
+            char digit = '0';
+            while (value >= power) {
+                value -= power;
+                digit++;
+            }
+
+            if (leading && digit == '0' && ix < MAX_DIGITS - 1) {
+                if (MAX_DIGITS - ix <= width) {
+                    dest[length++] = ' ';
+                }
+                continue;
+            }
+            leading = false;
+            dest[length++] = digit;
+        }
+        return length;
+    }
+
+}} // namespace spaceshoot::hud
@@ -0,0 +1,61 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#ifndef SST_HUD_H
+#define SST_HUD_H
+
+#include "Configuration.h"
+#include <stdint.h>
+
+/* Text fields drawn from pre-rendered glyphs of a 3x5 font. Only the characters that have changed since the
+ * previous draw() are redrawn, each one together with its background. */
+namespace spaceshoot { namespace hud {
+
+    const size_t MAX_FIELDS = 4;
+    const size_t TEXT_POOL_SIZE = 64;
+
+    /* Glyphs are cached for these characters only, anything else is drawn as a space. Scale 2 fields can
+     * only show the first LARGE_GLYPHS of them. */
+    const char CHARSET[] = " 0123456789:.,/BFHMPS";
+    const size_t LARGE_GLYPHS = 12;
+
+    /* Renders the glyph cache from a font in the Gamebuino format, with 3x5 glyphs */
+    void init(const uint8_t* font);
+
+    /* A field of `length` characters; x must be even and scale is 1 or 2 (horizontally only) */
+    void setField(uint8_t index, int16_t x, uint8_t y, uint8_t scale, uint8_t color, uint8_t length);
+    /* Sets the text to show, padded with spaces or cut to the field length */
+    void setText(uint8_t index, const char* text);
+
+    /* Forgets what has been drawn, so that the next draw() repaints all fields */
+    void invalidate();
+    void draw(uint8_t* buffer);
+    /* Draws the part of all fields on the given line, regardless of what has changed (for the display list) */
+    void drawRow(uint8_t* line, uint8_t y);
+
+    /* Writes value right-aligned on width characters (or more, if needed) without dividing, returns the
+     * number of characters written. No terminating zero. */
+    uint8_t formatNumber(char* dest, uint32_t value, uint8_t width);
+
+}} // namespace spaceshoot::hud
+
+#endif // SST_HUD_H
@@ -23,76 +23,83 @@
 #include "InstructionsContext.h"
 #include "Tileset.h"
 #include "Utils.h"
-#include "font4x7.c"
-#include "utility/Graphics/font3x5.c"
+#include "StaticText.h"
+#include "Effects.h"
 
 namespace spaceshoot { namespace context { namespace instructions {
 
-    static const char STR_HEADER[] = "INSTRUCTIONS";
+    static constexpr auto STR_HEADER = text::rasterize<4, 2>("INSTRUCTIONS");
 
-    static const char STR_PAGING_FIRST[] = "\x13:next page";
-    static const char STR_PAGING_MID[] = "\x12:previous page \x13:next page";
-    static const char STR_PAGING_LAST[] = "\x12:previous page";
+    static constexpr auto STR_PAGING_FIRST = text::rasterize<4>("\x13:next page");
+    static constexpr auto STR_PAGING_MID = text::rasterize<4>("\x12:previous page \x13:next page");
+    static constexpr auto STR_PAGING_LAST = text::rasterize<4>("\x12:previous page");
     
-    static const char STR_RET_MENU[] = "\x02\x09:return to menu";
-
-    static const char STR_SHIP[] = "Your space ship.";
-    static const char STR_SHIP_CTRL1[] = "Use the D-Pad(\x12\x13)to move up";
-    static const char STR_SHIP_CTRL2[] = "and down. Press \x01\x08 button";
-    static const char STR_SHIP_CTRL3[] = "to fire missiles. You can keep";
-    static const char STR_SHIP_CTRL4[] = "these buttons pressed for conti-";
-    static const char STR_SHIP_CTRL5[] = "nuous movement and/or firing.";
-    static const char STR_BLOCKS1[] = "Debris to destroy. Don't";
-    static const char STR_BLOCKS2[] = "let them reach the station.";
-    static const char STR_SCORING1[] = "Each hit is worth 5 points.";
-    static const char STR_BLOCKS3[] = "A bomb. Shoot it to be able";
-    static const char STR_BLOCKS4[] = "to fire a salvo.";
-                                       /* -------|-------|-------|-------| */
-    static const char STR_BOMB_CTRL1[] = "You will see a red flash of the";
-    static const char STR_BOMB_CTRL2[] = "console lights when you collect";
-    static const char STR_BOMB_CTRL3[] = "one. Press \x02\x09 to use it. ";
-    static const char STR_BONUS_HINT1[] = "Again, you will see a green";
-    static const char STR_BONUS_HINT2[] = "flash on the right hand side if";
-    static const char STR_BONUS_HINT3[] = "you hit this block.";
-    static const char STR_LIGHTS_EN[] = "(unless you disabled the lights)";
-
-    static const char STR_CONTROLS4[] = "Press \x02\x09 button to fire a salvo";
-    static const char STR_CONTROLS5[] = "if equipped. ";
-    static const char STR_BLOCKS5[] = "A bonus block. Shoot it";
-    static const char STR_BLOCKS6[] = "to get extra points.";
-    static const char STR_SCORING2[] = "125 points, to be precise.";
-
-    static const char STR_HINT1A[] = "Bombs and bonus blocks turn into";
-    static const char STR_HINT1B[] = "stone when they are too close";
-    static const char STR_HINT1C[] = "(after passing halfway the dis-";
-    static const char STR_HINT1D[] = "tance). Better hit them as soon";
-    static const char STR_HINT1E[] = "as you can.";
-
-                                   /* -------|-------|-------|-------| */
-    static const char STR_HINT2A[] = "Don't waste your salvos while";
-    static const char STR_HINT2B[] = "the debris are far away.";
-    static const char STR_HINT2C[] = "Fire them when it gets really";
-    static const char STR_HINT2D[] = "hot! You'll see, close to";
-    static const char STR_HINT2E[] = "the end of the game you will";
-    static const char STR_HINT2F[] = "desperately need them.";
-
-                                   /* -------|-------|-------|-------| */
-    static const char STR_HINT3A[] = "Every salvo remaining is worth";
-    static const char STR_HINT3B[] = "100 points of bonus added"; 
-    static const char STR_HINT3C[] = "at the end of the game.";
-    static const char STR_HINT3D[] = "Maybe you should not use them";
-    static const char STR_HINT3E[] = "when the mission is lost anyway?";
-    static const char STR_HINT3F[] = "Keep in mind that good accuracy";
-    static const char STR_HINT3G[] = "is awarded...";
-
-    static const char STR_SCORING3A[] = "You can get up to 2000 points";
-    static const char STR_SCORING3B[] = "if you don't waste any shot.";
-    static const char STR_SCORING3C[] = "Clearing all the debris will";
-    static const char STR_SCORING3D[] = "give you extra 500 points...";
-    static const char STR_SCORING3E[] = "Go for it!";
-
-    static const char STR_HIDDEN1A[] = "Who told you that \x04\x14 button";
-    static const char STR_HIDDEN1B[] = "has any meaning here?";
+    static constexpr auto STR_RET_MENU = text::rasterize<4>("\x02\x09:return to menu");
+
+    static constexpr auto STR_SHIP = text::rasterize<1>("Your space ship.");
+    static constexpr auto STR_SHIP_CTRL1 = text::rasterize<1>("Use the D-Pad(\x12\x13)to move up");
+    static constexpr auto STR_SHIP_CTRL2 = text::rasterize<1>("and down. Press \x01\x08 button");
+    static constexpr auto STR_SHIP_CTRL3 = text::rasterize<1>("to fire missiles. You can keep");
+    static constexpr auto STR_SHIP_CTRL4 = text::rasterize<1>("these buttons pressed for conti-");
+    static constexpr auto STR_SHIP_CTRL5 = text::rasterize<1>("nuous movement and/or firing.");
+    static constexpr auto STR_BLOCKS1 = text::rasterize<1>("Debris to destroy. Don't");
+    static constexpr auto STR_BLOCKS2 = text::rasterize<1>("let them reach the station.");
+    static constexpr auto STR_SCORING1 = text::rasterize<1>("Each hit is worth 5 points.");
+    static constexpr auto STR_BLOCKS3 = text::rasterize<1>("A bomb. Shoot it to be able");
+    static constexpr auto STR_BLOCKS4 = text::rasterize<1>("to fire a salvo.");
+                                                              /* -------|-------|-------|-------| */
+    static constexpr auto STR_BOMB_CTRL1 = text::rasterize<1>("You will see a red flash of the");
+    static constexpr auto STR_BOMB_CTRL2 = text::rasterize<1>("console lights when you collect");
+    static constexpr auto STR_BOMB_CTRL3 = text::rasterize<1>("one. Press \x02\x09 to use it. ");
+    static constexpr auto STR_BONUS_HINT1 = text::rasterize<1>("Again, you will see a green");
+    static constexpr auto STR_BONUS_HINT2 = text::rasterize<1>("flash on the right hand side if");
+    static constexpr auto STR_BONUS_HINT3 = text::rasterize<1>("you hit this block.");
+    static constexpr auto STR_LIGHTS_EN = text::rasterize<1>("(unless you disabled the lights)");
+
+    static constexpr auto STR_CONTROLS4 = text::rasterize<1>("Press \x02\x09 button to fire a salvo");
+    static constexpr auto STR_CONTROLS5 = text::rasterize<1>("if equipped. ");
+    static constexpr auto STR_BLOCKS5 = text::rasterize<1>("A bonus block. Shoot it");
+    static constexpr auto STR_BLOCKS6 = text::rasterize<1>("to get extra points.");
+    static constexpr auto STR_SCORING2 = text::rasterize<1>("125 points, to be precise.");
+
+    static constexpr auto STR_HINT1A = text::rasterize<1>("Bombs and bonus blocks turn into");
+    static constexpr auto STR_HINT1B = text::rasterize<1>("stone when they are too close");
+    static constexpr auto STR_HINT1C = text::rasterize<1>("(after passing halfway the dis-");
+    static constexpr auto STR_HINT1D = text::rasterize<1>("tance). Better hit them as soon");
+    static constexpr auto STR_HINT1E = text::rasterize<1>("as you can.");
+
+                                                          /* -------|-------|-------|-------| */
+    static constexpr auto STR_HINT2A = text::rasterize<1>("Don't waste your salvos while");
+    static constexpr auto STR_HINT2B = text::rasterize<1>("the debris are far away.");
+    static constexpr auto STR_HINT2C = text::rasterize<1>("Fire them when it gets really");
+    static constexpr auto STR_HINT2D = text::rasterize<1>("hot! You'll see, close to");
+    static constexpr auto STR_HINT2E = text::rasterize<1>("the end of the game you will");
+    static constexpr auto STR_HINT2F = text::rasterize<1>("desperately need them.");
+
+                                                          /* -------|-------|-------|-------| */
+    static constexpr auto STR_HINT3A = text::rasterize<1>("Every salvo remaining is worth");
+    static constexpr auto STR_HINT3B = text::rasterize<1>("100 points of bonus added"); 
+    static constexpr auto STR_HINT3C = text::rasterize<1>("at the end of the game.");
+    static constexpr auto STR_HINT3D = text::rasterize<1>("Maybe you should not use them");
+    static constexpr auto STR_HINT3E = text::rasterize<1>("when the mission is lost anyway?");
+    static constexpr auto STR_HINT3F = text::rasterize<1>("Keep in mind that good accuracy");
+    static constexpr auto STR_HINT3G = text::rasterize<1>("is awarded...");
+
+    static constexpr auto STR_SCORING3A = text::rasterize<1>("You can get up to 2000 points");
+    static constexpr auto STR_SCORING3B = text::rasterize<1>("if you don't waste any shot.");
+    static constexpr auto STR_SCORING3C = text::rasterize<1>("Clearing all the debris will");
+    static constexpr auto STR_SCORING3D = text::rasterize<1>("give you extra 500 points...");
+    static constexpr auto STR_SCORING3E = text::rasterize<1>("Go for it!");
+
+    static constexpr auto STR_HIDDEN1A = text::rasterize<1>("Who told you that \x04\x14 button");
+    static constexpr auto STR_HIDDEN1B = text::rasterize<1>("has any meaning here?");
+
+    /* The bonus shimmers through a palette of its own, see effects::updateGlow() */
+    static void setupGlowLines(uint8_t page, uint8_t slot) {
+        if (page == 2) {
+            memset(gb.tft.colorCells.paletteToLine + 25, slot, BLOCK_HEIGHT);
+        }
+    }
 
     static void setupPalettesForPages(uint8_t page) {
         switch (page) {
@@ -105,6 +112,7 @@ namespace spaceshoot { namespace context { namespace instructions {
             case 129:
                 memset(gb.tft.colorCells.paletteToLine + 0, 1, 20);
                 memset(gb.tft.colorCells.paletteToLine + 20, 0, 108);
+                setupGlowLines(page, effects::SLOT_GLOW);
                 break;
             case 127:
             case 130:
@@ -113,7 +121,7 @@ namespace spaceshoot { namespace context { namespace instructions {
         }
     }
 
-    void run(Image& tileSet) {
+    void run() {
         tileset::ElementID elements[] = {
             tileset::ElementID::ShipTail,
             tileset::ElementID::ShipFrontNormal,
@@ -148,6 +156,7 @@ namespace spaceshoot { namespace context { namespace instructions {
         gb.tft.colorCells.palettes[0] = tilesetPalette;
         gb.tft.colorCells.palettes[1] = defaultPalette;
         gb.tft.colorCells.enabled = true;
+        effects::begin(reinterpret_cast<const uint16_t*>(tilesetPalette));
 
         uint8_t page = 0;
         uint8_t f = 0;
@@ -158,144 +167,144 @@ namespace spaceshoot { namespace context { namespace instructions {
             gb.display.clear();
 
             if (page == 0) {
-                gb.display.setColor(2);
-                setTextFormat((ColorIndex)6, 2, 1, font4x7);
-                gb.display.print(0, 20, STR_HEADER);
+                text::setColor((ColorIndex)2);
+                text::setFormat((ColorIndex)6, 2, 1, text::FONT_4X7);
+                text::print(0, 20, STR_HEADER);
             
-                tileset::draw(tileSet, 4, 40, elements[0]);
-                tileset::draw(tileSet, 8, 40, elements[1]);
-                tileset::draw(tileSet, 8, 35, elements[2]);
-                tileset::draw(tileSet, 8, 40, elements[3]);
-
-                setTextFormat(COLOR_DESCRIPTION, 1, 1, font4x7);
-                gb.display.setColor(COLOR_DESCRIPTION);
-                gb.display.print(28, 38, STR_SHIP);
-
-                gb.display.setColor(COLOR_CONTROLS);
-                gb.display.print(0, 54, STR_SHIP_CTRL1);
-                gb.display.print(0, 64, STR_SHIP_CTRL2);
-                gb.display.print(0, 74, STR_SHIP_CTRL3);
-                gb.display.print(0, 84, STR_SHIP_CTRL4);
-                gb.display.print(0, 94, STR_SHIP_CTRL5);
+                tileset::draw(4, 40, elements[0]);
+                tileset::draw(8, 40, elements[1]);
+                tileset::draw(8, 35, elements[2]);
+                tileset::draw(8, 40, elements[3]);
+
+                text::setFormat(COLOR_DESCRIPTION, 1, 1, text::FONT_4X7);
+                text::setColor(COLOR_DESCRIPTION);
+                text::print(28, 38, STR_SHIP);
+
+                text::setColor(COLOR_CONTROLS);
+                text::print(0, 54, STR_SHIP_CTRL1);
+                text::print(0, 64, STR_SHIP_CTRL2);
+                text::print(0, 74, STR_SHIP_CTRL3);
+                text::print(0, 84, STR_SHIP_CTRL4);
+                text::print(0, 94, STR_SHIP_CTRL5);
             }
 
             if (page == 1) {
-                tileset::draw(tileSet, 4, 20, elements[4]);
-                tileset::draw(tileSet, 10, 20, elements[5]);
-                tileset::draw(tileSet, 16, 20, elements[6]);
-                tileset::draw(tileSet, 4, 26, elements[7]);
-                tileset::draw(tileSet, 10, 26, elements[8]);
-                tileset::draw(tileSet, 16, 26, elements[9]);
-                tileset::draw(tileSet, 7, 32, elements[10]);
-                tileset::draw(tileSet, 13, 32, elements[11]);
+                tileset::draw(4, 20, elements[4]);
+                tileset::draw(10, 20, elements[5]);
+                tileset::draw(16, 20, elements[6]);
+                tileset::draw(4, 26, elements[7]);
+                tileset::draw(10, 26, elements[8]);
+                tileset::draw(16, 26, elements[9]);
+                tileset::draw(7, 32, elements[10]);
+                tileset::draw(13, 32, elements[11]);
                 
-                setTextFormat(COLOR_DESCRIPTION, 1, 1, font4x7);
-                gb.display.print(24, 20, STR_BLOCKS1);
-                gb.display.print(24, 30, STR_BLOCKS2);
+                text::setFormat(COLOR_DESCRIPTION, 1, 1, text::FONT_4X7);
+                text::print(24, 20, STR_BLOCKS1);
+                text::print(24, 30, STR_BLOCKS2);
                 
-                gb.display.setColor(COLOR_SCORING);
-                gb.display.print(0, 40, STR_SCORING1);
+                text::setColor(COLOR_SCORING);
+                text::print(0, 40, STR_SCORING1);
 
-                tileset::draw(tileSet, 4, 60, elements[12]);
+                tileset::draw(4, 60, elements[12]);
 
-                gb.display.setColor(COLOR_DESCRIPTION);
-                gb.display.print(18, 55, STR_BLOCKS3);
-                gb.display.print(18, 65, STR_BLOCKS4);
-                gb.display.setColor(COLOR_CONTROLS);
-                gb.display.print(0, 80, STR_BOMB_CTRL1);
-                gb.display.print(0, 90, STR_BOMB_CTRL2);
-                gb.display.print(0, 100, STR_BOMB_CTRL3);
-                gb.display.setColor(COLOR_HINTS);
-                gb.display.print(0, 110, STR_LIGHTS_EN);
+                text::setColor(COLOR_DESCRIPTION);
+                text::print(18, 55, STR_BLOCKS3);
+                text::print(18, 65, STR_BLOCKS4);
+                text::setColor(COLOR_CONTROLS);
+                text::print(0, 80, STR_BOMB_CTRL1);
+                text::print(0, 90, STR_BOMB_CTRL2);
+                text::print(0, 100, STR_BOMB_CTRL3);
+                text::setColor(COLOR_HINTS);
+                text::print(0, 110, STR_LIGHTS_EN);
 
             }
             if (page == 2) {
-                setTextFormat(COLOR_DESCRIPTION, 1, 1, font4x7);
-                tileset::draw(tileSet, 4, 25, elements[13]);
+                text::setFormat(COLOR_DESCRIPTION, 1, 1, text::FONT_4X7);
+                tileset::draw(4, 25, elements[13]);
                 
-                gb.display.print(18, 20, STR_BLOCKS5);
-                gb.display.print(18, 30, STR_BLOCKS6);
-
-                gb.display.setColor(COLOR_SCORING);
-                gb.display.print(0, 40, STR_SCORING2);
-
-                gb.display.setColor(COLOR_HINTS);
-                gb.display.print(0, 53, STR_BONUS_HINT1);
-                gb.display.print(0, 62, STR_BONUS_HINT2);
-                gb.display.print(0, 71, STR_BONUS_HINT3);
-
-                gb.display.print(0, 84, STR_HINT1A);
-                gb.display.print(0, 93, STR_HINT1B);
-                gb.display.print(0, 102, STR_HINT1C);
-                gb.display.print(0, 111, STR_HINT1D);
-                gb.display.print(0, 120, STR_HINT1E);
+                text::print(18, 20, STR_BLOCKS5);
+                text::print(18, 30, STR_BLOCKS6);
+
+                text::setColor(COLOR_SCORING);
+                text::print(0, 40, STR_SCORING2);
+
+                text::setColor(COLOR_HINTS);
+                text::print(0, 53, STR_BONUS_HINT1);
+                text::print(0, 62, STR_BONUS_HINT2);
+                text::print(0, 71, STR_BONUS_HINT3);
+
+                text::print(0, 84, STR_HINT1A);
+                text::print(0, 93, STR_HINT1B);
+                text::print(0, 102, STR_HINT1C);
+                text::print(0, 111, STR_HINT1D);
+                text::print(0, 120, STR_HINT1E);
             }
 
             if (page == 3) {
-                setTextFormat(COLOR_HINTS, 1, 1, font4x7);
-                gb.display.print(0, 20, STR_HINT2A);
-                gb.display.print(0, 30, STR_HINT2B);
-                gb.display.print(0, 40, STR_HINT2C);
-                gb.display.print(0, 50, STR_HINT2D);
-                gb.display.print(0, 60, STR_HINT2E);
-                gb.display.print(0, 70, STR_HINT2F);
-
-                gb.display.print(0, 85, STR_HINT3A);
-                gb.display.print(0, 95, STR_HINT3B);
-                gb.display.print(0, 105, STR_HINT3C);
-                gb.display.print(0, 115, STR_HINT3D);
+                text::setFormat(COLOR_HINTS, 1, 1, text::FONT_4X7);
+                text::print(0, 20, STR_HINT2A);
+                text::print(0, 30, STR_HINT2B);
+                text::print(0, 40, STR_HINT2C);
+                text::print(0, 50, STR_HINT2D);
+                text::print(0, 60, STR_HINT2E);
+                text::print(0, 70, STR_HINT2F);
+
+                text::print(0, 85, STR_HINT3A);
+                text::print(0, 95, STR_HINT3B);
+                text::print(0, 105, STR_HINT3C);
+                text::print(0, 115, STR_HINT3D);
             }
 
             if (page == 4) {
-                setTextFormat(COLOR_HINTS, 1, 1, font4x7);
+                text::setFormat(COLOR_HINTS, 1, 1, text::FONT_4X7);
                 
-                gb.display.print(0, 20, STR_HINT3E);
-                gb.display.print(0, 30, STR_HINT3F);
-                gb.display.print(0, 40, STR_HINT3G);
+                text::print(0, 20, STR_HINT3E);
+                text::print(0, 30, STR_HINT3F);
+                text::print(0, 40, STR_HINT3G);
 
-                setTextFormat(COLOR_SCORING, 1, 1, font4x7);
+                text::setFormat(COLOR_SCORING, 1, 1, text::FONT_4X7);
 
-                gb.display.print(0, 55, STR_SCORING3A);
-                gb.display.print(0, 65, STR_SCORING3B);
-                gb.display.print(0, 75, STR_SCORING3C);
-                gb.display.print(0, 85, STR_SCORING3D);
-                gb.display.print(0, 95, STR_SCORING3E);
+                text::print(0, 55, STR_SCORING3A);
+                text::print(0, 65, STR_SCORING3B);
+                text::print(0, 75, STR_SCORING3C);
+                text::print(0, 85, STR_SCORING3D);
+                text::print(0, 95, STR_SCORING3E);
             }
 
             if (page == 127) {
-                setTextFormat(INDEX_BEIGE, 1, 1, font4x7);
-                gb.display.print(0, 60, STR_HIDDEN1A);
-                gb.display.print(0, 68, STR_HIDDEN1B);
+                text::setFormat(INDEX_BEIGE, 1, 1, text::FONT_4X7);
+                text::print(0, 60, STR_HIDDEN1A);
+                text::print(0, 68, STR_HIDDEN1B);
 
             }
 
             if (page == 128) {
-                gb.display.setColor(2);
-                setTextFormat((ColorIndex)6, 2, 1, font4x7);
-                gb.display.print(0, 20, "CUSTOM 4x7 FONT");
+                text::setColor((ColorIndex)2);
+                text::setFormat((ColorIndex)6, 2, 1, text::FONT_4X7);
+                text::print(0, 20, "CUSTOM 4x7 FONT");
 
-                setTextFormat(COLOR_DESCRIPTION, 1, 1, font4x7);
+                text::setFormat(COLOR_DESCRIPTION, 1, 1, text::FONT_4X7);
                 for (uint8_t y = 0; y < 8; y++) {
                     for (uint8_t x = 0; x < 16; x++) {
-                        gb.display.drawChar(x * 9, 40 + y * 8, (char)(y * 16 + x), 1);
+                        text::drawChar(x * 9, 40 + y * 8, (char)(y * 16 + x));
                     }
                 }
             }
 
             if (page == 129 || page == 130) {
-                gb.display.setColor(2);
-                setTextFormat((ColorIndex)6, 2, 1, font4x7);
+                text::setColor((ColorIndex)2);
+                text::setFormat((ColorIndex)6, 2, 1, text::FONT_4X7);
                 if (page == 129) {
-                    gb.display.print(0, 20, "TILESET PALETTE");
+                    text::print(0, 20, "TILESET PALETTE");
                 } else {
-                    gb.display.print(0, 20, "DEFAULT PALETTE");
+                    text::print(0, 20, "DEFAULT PALETTE");
                 }
 
-                setTextFormat(COLOR_DESCRIPTION, 1, 3, font4x7);
+                text::setFormat(COLOR_DESCRIPTION, 1, 3, text::FONT_4X7);
                 for (uint8_t y = 0; y < 4; y++) {
                     for (uint8_t x = 0; x < 4; x++) {
-                        gb.display.setColor(COLOR_DESCRIPTION);
-                        gb.display.printf(40 * x + 5, 20 * y + 40, "%d", (y*4+x));
+                        text::setColor(COLOR_DESCRIPTION);
+                        text::printf(40 * x + 5, 20 * y + 40, "%d", (y*4+x));
                         gb.display.setColor((ColorIndex)(y*4+x));
                         gb.display.fillRect(40 * x + 16, 20 * y + 40, 20, 24);
                     }
@@ -303,20 +312,21 @@ namespace spaceshoot { namespace context { namespace instructions {
 
             }
             
-            setTextFormat((ColorIndex)1, 1, 1, font4x7);
+            text::setFormat((ColorIndex)1, 1, 1, text::FONT_4X7);
 
-            gb.display.setColor((ColorIndex)1);
+            text::setColor((ColorIndex)1);
             if (page == 0) {
-                gb.display.print(0, 0, STR_PAGING_FIRST);
+                text::print(0, 0, STR_PAGING_FIRST);
             } else if (page == 4) {
-                gb.display.print(0, 0, STR_PAGING_LAST);
+                text::print(0, 0, STR_PAGING_LAST);
             } else {
-                gb.display.print(0, 0, STR_PAGING_MID);
+                text::print(0, 0, STR_PAGING_MID);
             }
             
-            gb.display.print(0, 8, STR_RET_MENU);
+            text::print(0, 8, STR_RET_MENU);
 
             tileset::updateAnimation(elements, sizeof(elements) / sizeof(elements[0]));
+            effects::updateGlow();
 
             if ((f & 0x7F) == 0x20) {
                 elements[1] = tileset::ElementID::ShipFiringLeft;
@@ -343,6 +353,7 @@ namespace spaceshoot { namespace context { namespace instructions {
             }
 
             if (gb.buttons.pressed(BUTTON_B)) {
+                setupGlowLines(page, 0);
                 paletteSyncFadeToBlack(0, 1, 12);
                 return;
             }
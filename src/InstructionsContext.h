@@ -26,7 +26,7 @@
 #include "Gamebuino-Meta-ADTCRV.h"
 
 namespace spaceshoot { namespace context { namespace instructions {
-        void run(Image& tileSet);
+        void run();
 }}} // namespace spaceshoot::context::instructions
 
 #endif // SST_INSTRUCTIONSCONTEXT_H
@@ -0,0 +1,231 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#include "LowResRenderer.h"
+#include "Tileset.h"
+#include "Sprites.h"
+#include "Starfield.h"
+#include "Hud.h"
+#include "Effects.h"
+#include "Raster.h"
+#include "Gamebuino-Meta-ADTCRV.h"
+#include <string.h>
+
+namespace spaceshoot { namespace lowresrenderer {
+
+    using ElementID = tileset::ElementID;
+
+    const uint8_t MISSILE_COLOR = 12;
+    const int16_t FIELD_BOTTOM = GAMEBOARD_Y + NUM_ROWS * BLOCK_HEIGHT;
+    const int16_t LOWRES_FIELD_BOTTOM = LOWRES_GAMEBOARD_Y + NUM_ROWS * LOWRES_BLOCK_HEIGHT;
+
+    static_assert(SCREEN_WIDTH == 2 * LOWRES_SCREEN_WIDTH);
+    static_assert(LOWRES_BLOCK_WIDTH == 2 && LOWRES_BLOCK_HEIGHT == 2);
+
+    /* Each quarter of a tile takes its most frequent opaque color, if at least a third of it is opaque. Thin
+     * shapes would disappear if the transparent pixels could outvote them. */
+    struct Tile {
+        bool opaque[2][2];
+        uint16_t color[2][2];
+    };
+
+    static Tile tiles[static_cast<size_t>(ElementID::Count)];
+    static const uint16_t* tilesPalette;
+    static bool active;
+    static bool colorCellsEnabled;
+
+    static inline uint16_t* framebuffer() {
+        return gb.display._buffer;
+    }
+
+    static void convertTile(ElementID id, const uint16_t* palette, Tile& tile) {
+        /* Rows 0-2 go to the upper half, rows 2-4 to the lower one */
+        uint8_t counts[2][2][16];
+        memset(counts, 0, sizeof(counts));
+        for (uint8_t row = 0; row < BLOCK_HEIGHT; row++) {
+            uint8_t line[BLOCK_WIDTH / 2] = {0};
+            tileset::drawRow(line, 0, id, row);
+            for (uint8_t px = 0; px < BLOCK_WIDTH; px++) {
+                uint8_t index = (line[px >> 1] >> ((px & 0x01) ? 0 : 4)) & 0x0F;
+                if (row <= BLOCK_HEIGHT / 2) {
+                    counts[0][px >> 1][index]++;
+                }
+                if (row >= BLOCK_HEIGHT / 2) {
+                    counts[1][px >> 1][index]++;
+                }
+            }
+        }
+
+        for (uint8_t y = 0; y < 2; y++) {
+            for (uint8_t x = 0; x < 2; x++) {
+                uint8_t best = 1;
+                uint8_t opaque = counts[y][x][1];
+                for (uint8_t index = 2; index < 16; index++) {
+                    opaque += counts[y][x][index];
+                    if (counts[y][x][index] > counts[y][x][best]) {
+                        best = index;
+                    }
+                }
+                tile.opaque[y][x] = opaque * 3 >= opaque + counts[y][x][0];
+                tile.color[y][x] = palette[best];
+            }
+        }
+    }
+
+    void begin() {
+        if (active) {
+            return;
+        }
+        tilesPalette = reinterpret_cast<const uint16_t*>(gb.tft.colorCells.palettes[0]);
+        for (size_t id = 0; id < static_cast<size_t>(ElementID::Count); id++) {
+            convertTile(static_cast<ElementID>(id), tilesPalette, tiles[id]);
+        }
+
+        /* Line palettes only apply to the indexed framebuffer, the HUD is converted with them here */
+        colorCellsEnabled = gb.tft.colorCells.enabled;
+        gb.tft.colorCells.enabled = false;
+        gb.display.init(LOWRES_SCREEN_WIDTH, LOWRES_SCREEN_HEIGHT, LOWRES_SCREEN_MODE);
+        active = true;
+    }
+
+    void end() {
+        if (active) {
+            gb.display.init(SCREEN_WIDTH, SCREEN_HEIGHT, SCREEN_MODE);
+            gb.tft.colorCells.enabled = colorCellsEnabled;
+            active = false;
+        }
+    }
+
+    /* The field is squeezed from 5 to 2 lines per block, the HUD bars keep their lines */
+    static inline int16_t mapY(int16_t y) {
+        if (y < (int16_t)GAMEBOARD_Y) {
+            return y;
+        }
+        if (y >= FIELD_BOTTOM) {
+            return y - FIELD_BOTTOM + LOWRES_FIELD_BOTTOM;
+        }
+        return LOWRES_GAMEBOARD_Y + (y - GAMEBOARD_Y) * LOWRES_BLOCK_HEIGHT / BLOCK_HEIGHT;
+    }
+
+    static inline void setPixel(int16_t x, int16_t y, uint16_t color) {
+        if (x >= 0 && x < (int16_t)LOWRES_SCREEN_WIDTH && y >= 0 && y < (int16_t)LOWRES_SCREEN_HEIGHT) {
+            framebuffer()[y * LOWRES_SCREEN_WIDTH + x] = color;
+        }
+    }
+
+    /* At low resolution coordinates */
+    static void drawTile(int16_t x, int16_t y, ElementID id) {
+        const Tile& tile = tiles[static_cast<uint8_t>(id)];
+        for (uint8_t ty = 0; ty < 2; ty++) {
+            const int16_t lineY = y + ty;
+            if (lineY < 0 || lineY >= (int16_t)LOWRES_SCREEN_HEIGHT) {
+                continue;
+            }
+            uint16_t* line = framebuffer() + lineY * LOWRES_SCREEN_WIDTH;
+            for (uint8_t tx = 0; tx < 2; tx++) {
+                const int16_t pixelX = x + tx;
+                if (tile.opaque[ty][tx] && pixelX >= 0 && pixelX < (int16_t)LOWRES_SCREEN_WIDTH) {
+                    line[pixelX] = tile.color[ty][tx];
+                }
+            }
+        }
+    }
+
+    static void drawSpriteTile(int16_t x, int16_t y, ElementID id) {
+        drawTile(x >> 1, mapY(y), id);
+    }
+
+    /* Both halves of a pixel pair, the left one unless it is background */
+    static void convertHudLine(const uint8_t* line, uint16_t* dest, uint8_t y) {
+        const uint16_t* palette = reinterpret_cast<const uint16_t*>(
+                gb.tft.colorCells.palettes[gb.tft.colorCells.paletteToLine[y]]);
+        for (uint8_t x = 0; x < LOWRES_SCREEN_WIDTH; x++) {
+            const uint8_t pair = line[x];
+            dest[x] = palette[(pair >> 4) ? (pair >> 4) : (pair & 0x0F)];
+        }
+    }
+
+    static void drawHud() {
+        uint8_t line[raster::LINE_BYTES];
+        for (uint8_t y = 0; y < LOWRES_SCREEN_HEIGHT; y++) {
+            if (y == LOWRES_GAMEBOARD_Y) {
+                y = LOWRES_FIELD_BOTTOM;
+            }
+            const uint8_t sourceY = y < LOWRES_GAMEBOARD_Y ? y : y - LOWRES_FIELD_BOTTOM + FIELD_BOTTOM;
+            memset(line, 0, sizeof(line));
+            hud::drawRow(line, sourceY);
+            convertHudLine(line, framebuffer() + y * LOWRES_SCREEN_WIDTH, sourceY);
+        }
+    }
+
+    static void drawStars(uint32_t frame) {
+        for (size_t ix = 0; ix < starfield::count(); ix++) {
+            int16_t x, y;
+            starfield::getPosition(ix, frame, x, y);
+            if (x < (int16_t)SCREEN_WIDTH) {
+                setPixel(x >> 1, mapY(y), tilesPalette[starfield::getColor(ix)]);
+            }
+        }
+    }
+
+    static void drawGameField(context::game::Context& ctx, uint8_t spriteDx) {
+        const uint8_t dx = spriteDx >> 1;
+        int16_t drawY = LOWRES_GAMEBOARD_Y;
+
+        for (size_t row = 0; row < NUM_ROWS; row++) {
+            int16_t drawX = LOWRES_PLAYER_WIDTH + NUM_COLS * LOWRES_BLOCK_WIDTH;
+
+            for (size_t col = NUM_COLS - 1; col < NUM_COLS; col--) {
+                auto blk = context::game::getBlock(ctx, row, col);
+                if (blk != ElementID::None) {
+                    drawTile(drawX - dx, drawY, blk);
+                }
+                /* A missile is a single pixel, its hi-res line has a margin above and below */
+                if (context::game::getMissile(ctx, row, col)) {
+                    setPixel(drawX, drawY, tilesPalette[MISSILE_COLOR]);
+                }
+                drawX -= LOWRES_BLOCK_WIDTH;
+            }
+            drawY += LOWRES_BLOCK_HEIGHT;
+        }
+    }
+
+    void drawFrame(context::game::Context& ctx, uint8_t spriteDx) {
+        memset(framebuffer() + LOWRES_GAMEBOARD_Y * LOWRES_SCREEN_WIDTH, 0,
+                (LOWRES_FIELD_BOTTOM - LOWRES_GAMEBOARD_Y) * LOWRES_SCREEN_WIDTH * sizeof(uint16_t));
+        drawHud();
+        /* There are no palettes at this color depth, the shimmer is baked into the tile every frame */
+        convertTile(ElementID::Bonus1, effects::glowPalette(), tiles[static_cast<size_t>(ElementID::Bonus1)]);
+        if (ctx.flags & context::game::FLAG_SHOW_BACKGROUND) {
+            drawStars(gb.frameCount);
+        }
+        drawGameField(ctx, spriteDx);
+        sprites::forEachTile(drawSpriteTile);
+    }
+
+    void plotPixel(int16_t x, int16_t y, uint8_t color) {
+        if (y >= (int16_t)GAMEBOARD_Y && y < FIELD_BOTTOM) {
+            setPixel(x >> 1, mapY(y), tilesPalette[color]);
+        }
+    }
+
+}} // namespace spaceshoot::lowresrenderer
@@ -0,0 +1,47 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#ifndef SST_LOWRESRENDERER_H
+#define SST_LOWRESRENDERER_H
+
+#include "Configuration.h"
+#include "GameContext.h"
+#include <stdint.h>
+
+/* Gameplay screen of the low resolution profile: 80x64 in 16-bit color, each block a 2x2 downsampled tile.
+ * Positions are given in the coordinates of the regular profile and mapped to the low resolution ones. */
+namespace spaceshoot { namespace lowresrenderer {
+
+    /* Switches gb.display to the low resolution profile and converts the tiles through the current tiles
+     * palette (colorCells palette 0) */
+    void begin();
+    /* Back to the regular profile, with undefined framebuffer contents */
+    void end();
+
+    /* Draws the HUD, the stars, the game field and the sprites. The HUD texts have to be set already. */
+    void drawFrame(context::game::Context& ctx, uint8_t spriteDx);
+    /* Particles, after drawFrame() */
+    void plotPixel(int16_t x, int16_t y, uint8_t color);
+
+}} // namespace spaceshoot::lowresrenderer
+
+#endif // SST_LOWRESRENDERER_H
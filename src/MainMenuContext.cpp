@@ -22,11 +22,14 @@
 
 #include "MainMenuContext.h"
 #include "GameContext.h"
+#include "StripRenderer.h"
+#include "Raster.h"
 #include "TitleScreenContext.h"
 #include "Configuration.h"
 #include "Utils.h"
+#include "StaticText.h"
+#include "Menu.h"
 #include "utility/Misc.h"
-#include "font4x7.c"
 #include "TitleSoundtrack.h"
 
 namespace spaceshoot { namespace context { namespace mainmenu {
@@ -36,6 +39,7 @@ namespace spaceshoot { namespace context { namespace mainmenu {
     const char STR_STORY[] = "Story";
     const char STR_INSTRUCTIONS[] = "Instructions";
     const char STR_SETTINGS[] = "Settings";
+    const char STR_BENCHMARK[] = "Benchmark";
     const char STR_RETURN_TO_BOOTLOADER[] = "Return to loader";
 
     const char STR_GAME_DIFFICULTY[] = "Difficulty";
@@ -53,59 +57,59 @@ namespace spaceshoot { namespace context { namespace mainmenu {
     const char STR_SHOW_PROFILING_INFO[] = "Show profiling statistics";
     const char STR_SHOW_BACKGROUND[] = "Draw background stars";
 
-    const char KEYS_HELP_M1[] = "\x13\x12:navigate menu, \x01\x08:confirm";
-    const char KEYS_HELP_O1[] = "\x13\x12:navigate menu, \x02\x09:return";
-    const char KEYS_HELP_O2[] = "\x11\x10:adjust selected setting";
+    const char STR_RENDERER[] = "Renderer";
+    const char STR_RENDERER_INCREMENTAL[] = "  Incremental \x10";
+    const char STR_RENDERER_SCANLINE[] = "\x11 Scanline \x10";
+    const char STR_RENDERER_STRIPS[] = "\x11 Strips, %u B freed \x10";
+    const char STR_RENDERER_LOWRES[] = "\x11 80x64, 16-bit color  ";
 
-    const uint8_t PAL_IDX_MENUPOS = 1;
-    const ColorIndex COLOR_MENUPOS_BG_INACTIVE = (ColorIndex)0;
-    const ColorIndex COLOR_MENUPOS_BG_ACTIVE = (ColorIndex)1;
-    const ColorIndex COLOR_MENUPOS_BG_ACTIVE_PARAM = (ColorIndex)2;
-    const ColorIndex COLOR_MENUPOS_FG_INACTIVE = (ColorIndex)3;
-    const ColorIndex COLOR_MENUPOS_FG_ACTIVE = (ColorIndex)4;
-    const ColorIndex COLOR_MENUPOS_FG_ACTIVE_PARAM = (ColorIndex)5;
+    static constexpr auto KEYS_HELP_M1 = text::rasterize<4>("\x13\x12:navigate menu, \x01\x08:confirm");
+    static constexpr auto KEYS_HELP_O1 = text::rasterize<4>("\x13\x12:navigate menu, \x02\x09:return");
+    static constexpr auto KEYS_HELP_O2 = text::rasterize<4>("\x11\x10:adjust selected setting");
 
     enum struct VisibleScreen {
         Main = 0,
         Settings = 1
     };
 
-    static void drawMenuPositionGeneric(uint8_t x, uint8_t y, const char* str, ColorIndex bgColor, ColorIndex fgColor, bool invertedPalette) {
-        for (size_t py = y - 2; py < y + 9; py++) {
-            int k = invertedPalette ? (7 - (py - y)) : py - y;
-            uint8_t palIndex = k < 0 ? 0 : (k > 7 ? 7 : k);
-
-            gb.tft.colorCells.paletteToLine[py] = PAL_IDX_MENUPOS + palIndex;
-        }
-
-        /* Fast lines' fill */
-        uint8_t f = (int)bgColor;
-        memset(gb.display._buffer + (y-2) * SCREEN_WIDTH / 4, (f << 4) | f, SCREEN_WIDTH * 11 / 2);
-        
-        gb.display.setColor(fgColor);
-        //if (str == STR_NEW_GAME || str == STR_GAME_DIFFICULTY) {
-        //    gb.display.printf(x, y, "%d, %d", gb.frameDurationMicros, gb.getCpuLoad());
-        //} else {
-        gb.display.print(x, y, str);
-        //}
-    }
-
-    static void drawMenuPosition(uint8_t x, uint8_t y, const char* str, bool selected) {
-        drawMenuPositionGeneric(x, y, str,
-                selected ? COLOR_MENUPOS_BG_ACTIVE : COLOR_MENUPOS_BG_INACTIVE,
-                selected ? COLOR_MENUPOS_FG_ACTIVE : COLOR_MENUPOS_FG_INACTIVE, false);
-
-    }
+    static const char* const DIFFICULTY_OPTIONS[] = {
+        STR_GAME_DIFFICULTY_L1, STR_GAME_DIFFICULTY_L2, STR_GAME_DIFFICULTY_L3,
+        STR_GAME_DIFFICULTY_L4, STR_GAME_DIFFICULTY_L5, STR_GAME_DIFFICULTY_L6
+    };
+    static const char* const YES_NO_OPTIONS[] = { STR_NO, STR_YES };
 
-    static void drawMenuPositionParam(uint8_t y, const char* str, bool selected) {
-        drawMenuPositionGeneric(SCREEN_WIDTH - 5 * strlen(str), y, str,
-                selected ? COLOR_MENUPOS_BG_ACTIVE_PARAM : COLOR_MENUPOS_BG_INACTIVE,
-                selected ? COLOR_MENUPOS_FG_ACTIVE_PARAM : COLOR_MENUPOS_FG_INACTIVE, false);
+    static char rendererStripsStr[32];
+    static const char* const RENDERER_OPTIONS[] = { STR_RENDERER_INCREMENTAL, STR_RENDERER_SCANLINE, rendererStripsStr,
+            STR_RENDERER_LOWRES };
+    static_assert(sizeof(RENDERER_OPTIONS) / sizeof(RENDERER_OPTIONS[0]) == static_cast<size_t>(game::RenderMode::Count));
+    static_assert(sizeof(game::RenderMode) == sizeof(uint8_t));
 
+    static void initMainScreen(menu::Screen& screen) {
+        menu::init(screen, menu::Layout::Centered, 30, 10);
+        menu::add(screen, menu::action(STR_NEW_GAME));
+#ifdef HIGHSCORES_IMPLEMENTED
+        menu::add(screen, menu::action(STR_HIGHSCORES));
+#endif
+#ifdef STORY_IMPLEMENTED
+        menu::add(screen, menu::action(STR_STORY));
+#endif
+        menu::add(screen, menu::action(STR_INSTRUCTIONS));
+        menu::add(screen, menu::action(STR_SETTINGS));
+        menu::add(screen, menu::action(STR_BENCHMARK));
+        menu::add(screen, menu::action(STR_RETURN_TO_BOOTLOADER));
     }
 
-    static void drawMenuPositionHCentered(uint8_t y, const char* str, bool selected) {
-        drawMenuPosition(SCREEN_WIDTH / 2 - 5 * strlen(str) / 2, y, str, selected);
+    static void initSettingsScreen(menu::Screen& screen, game::Context& ctx) {
+        snprintf(rendererStripsStr, sizeof(rendererStripsStr), STR_RENDERER_STRIPS, (unsigned int)striprenderer::RAM_FREED);
+
+        menu::init(screen, menu::Layout::Settings, 20, 22);
+        menu::add(screen, menu::choice(STR_GAME_DIFFICULTY, DIFFICULTY_OPTIONS,
+                sizeof(DIFFICULTY_OPTIONS) / sizeof(DIFFICULTY_OPTIONS[0]), ctx.difficultyLevel));
+        menu::add(screen, menu::flag(STR_SMOOTH_SCROLLING, YES_NO_OPTIONS, ctx.flags, game::FLAG_SMOOTH_SCROLLING));
+        menu::add(screen, menu::flag(STR_SHOW_BACKGROUND, YES_NO_OPTIONS, ctx.flags, game::FLAG_SHOW_BACKGROUND));
+        menu::add(screen, menu::flag(STR_SHOW_PROFILING_INFO, YES_NO_OPTIONS, ctx.flags, game::FLAG_SHOW_PROFILING_INFO));
+        menu::add(screen, menu::choice(STR_RENDERER, RENDERER_OPTIONS, static_cast<uint8_t>(game::RenderMode::Count),
+                reinterpret_cast<uint8_t&>(ctx.renderMode)));
     }
 
     static void setUpPalettes(uint16_t* palBg, uint16_t barsPalettes[8][16]) {
@@ -116,28 +120,31 @@ namespace spaceshoot { namespace context { namespace mainmenu {
         for (size_t ix = 0; ix < 8; ix++) {
             memcpy(barsPalettes[ix], Gamebuino_Meta::defaultColorPalette, sizeof(barsPalettes[ix]));
             
-            barsPalettes[ix][(int)COLOR_MENUPOS_BG_INACTIVE] = Gamebuino_Meta::rgb888Torgb565({0, ix * 6, ix * 9});
-            barsPalettes[ix][(int)COLOR_MENUPOS_FG_INACTIVE] = Gamebuino_Meta::rgb888Torgb565({ix * 16, ix * 16 + 127, ix * 16 + 127});
+            barsPalettes[ix][(int)menu::COLOR_MENUPOS_BG_INACTIVE] = Gamebuino_Meta::rgb888Torgb565({0, ix * 6, ix * 9});
+            barsPalettes[ix][(int)menu::COLOR_MENUPOS_FG_INACTIVE] = Gamebuino_Meta::rgb888Torgb565({ix * 16, ix * 16 + 127, ix * 16 + 127});
 
-            barsPalettes[ix][(int)COLOR_MENUPOS_BG_ACTIVE] = Gamebuino_Meta::rgb888Torgb565({255, ix * 16 + 127, ix * 4});
-            barsPalettes[ix][(int)COLOR_MENUPOS_FG_ACTIVE] = Gamebuino_Meta::rgb888Torgb565({ix * 2, ix * 4, 0});
+            barsPalettes[ix][(int)menu::COLOR_MENUPOS_BG_ACTIVE] = Gamebuino_Meta::rgb888Torgb565({255, ix * 16 + 127, ix * 4});
+            barsPalettes[ix][(int)menu::COLOR_MENUPOS_FG_ACTIVE] = Gamebuino_Meta::rgb888Torgb565({ix * 2, ix * 4, 0});
 
-            barsPalettes[ix][(int)COLOR_MENUPOS_BG_ACTIVE_PARAM] = Gamebuino_Meta::rgb888Torgb565({0, ix * 12 + 144, ix * 6 + 16});
-            barsPalettes[ix][(int)COLOR_MENUPOS_FG_ACTIVE_PARAM] = Gamebuino_Meta::rgb888Torgb565({ix * 4, ix * 16 , ix * 8});
+            barsPalettes[ix][(int)menu::COLOR_MENUPOS_BG_ACTIVE_PARAM] = Gamebuino_Meta::rgb888Torgb565({0, ix * 12 + 144, ix * 6 + 16});
+            barsPalettes[ix][(int)menu::COLOR_MENUPOS_FG_ACTIVE_PARAM] = Gamebuino_Meta::rgb888Torgb565({ix * 4, ix * 16 , ix * 8});
 
-            gb.tft.colorCells.palettes[PAL_IDX_MENUPOS + ix] = (Color*) barsPalettes[ix];
+            gb.tft.colorCells.palettes[menu::PAL_IDX_MENUPOS + ix] = (Color*) barsPalettes[ix];
         }
     }
 
     MenuPosition run(game::Context& ctx) {
-        int position = 0;
-        size_t dx;
         uint16_t palBg[16];
         uint16_t barsPalettes[8][16];
         setUpPalettes(palBg, barsPalettes);
 
         Image backgroundImage(titlescreen::gameLogoData);
 
+        menu::Screen mainScreen;
+        menu::Screen settingsScreen;
+        initMainScreen(mainScreen);
+        initSettingsScreen(settingsScreen, ctx);
+
         VisibleScreen screen = VisibleScreen::Main;
 
         bool fullRepaint = true;
@@ -153,135 +160,44 @@ namespace spaceshoot { namespace context { namespace mainmenu {
             if (playMusicInMainMenu) {
                 title_soundtrack::play();
             }
-            
-            if (fullRepaint) {
-                gb.display.clear();
-                gb.display.drawImage(0, 0, backgroundImage);
-                memset(gb.tft.colorCells.paletteToLine, 0, SCREEN_HEIGHT);
-                gb.display.setFont(font4x7);
-
-                fullRepaint = false;
-            }
-
-            if (screen == VisibleScreen::Main) {
-                uint8_t y = 20;
-                drawMenuPositionHCentered((y+=10), STR_NEW_GAME, static_cast<MenuPosition>(position) == MenuPosition::NewGame);
-#ifdef HIGHSCORES_IMPLEMENTED
-                drawMenuPositionHCentered((y+=10), STR_HIGHSCORES, static_cast<MenuPosition>(position) == MenuPosition::Highscores);
-#endif
-#ifdef STORY_IMPLEMENTED
-                drawMenuPositionHCentered((y+=10), STR_STORY, static_cast<MenuPosition>(position) == MenuPosition::Story);
-#endif
-                drawMenuPositionHCentered((y+=10), STR_INSTRUCTIONS, static_cast<MenuPosition>(position) == MenuPosition::Instructions);
-                drawMenuPositionHCentered((y+=10), STR_SETTINGS, static_cast<MenuPosition>(position) == MenuPosition::Settings);
-                drawMenuPositionHCentered((y+=10), STR_RETURN_TO_BOOTLOADER, static_cast<MenuPosition>(position) == MenuPosition::ReturnToBootloader);
-
-                gb.display.setColor(12);
-                gb.display.print(10, 0, KEYS_HELP_M1);
-            }
-
-            if (screen == VisibleScreen::Settings) {
-                drawMenuPosition(0, 24, STR_GAME_DIFFICULTY, position == 0);
-                drawMenuPosition(0, 50, STR_SMOOTH_SCROLLING, position == 1);
-                drawMenuPosition(0, 76, STR_SHOW_BACKGROUND, position == 2);
-                drawMenuPosition(0, 102, STR_SHOW_PROFILING_INFO, position == 3);
-
-                const char* s;
-                switch (ctx.difficultyLevel) {
-                    case 0: s = STR_GAME_DIFFICULTY_L1; break;
-                    case 1: s = STR_GAME_DIFFICULTY_L2; break;
-                    case 2: s = STR_GAME_DIFFICULTY_L3; break;
-                    case 3: s = STR_GAME_DIFFICULTY_L4; break;
-                    case 4: s = STR_GAME_DIFFICULTY_L5; break;
-                    case 5: s = STR_GAME_DIFFICULTY_L6; break;
-                }
-
-                // TODO: refactor
 
-                drawMenuPositionParam(35, s, position == 0);
+            const int8_t action = menu::update(screen == VisibleScreen::Main ? mainScreen : settingsScreen);
 
-                if (ctx.flags & game::FLAG_SMOOTH_SCROLLING) {
-                    s = STR_YES;
-                } else {
-                    s = STR_NO;
-                }
-
-                drawMenuPositionParam(61, s, position == 1);
-
-                if (ctx.flags & game::FLAG_SHOW_BACKGROUND) {
-                    s = STR_YES;
-                } else {
-                    s = STR_NO;
-                }
-
-                drawMenuPositionParam(87, s, position == 2);
-
-                if (ctx.flags & game::FLAG_SHOW_PROFILING_INFO) {
-                    s = STR_YES;
+            if (screen == VisibleScreen::Main && action != menu::NO_ACTION) {
+                if (static_cast<MenuPosition>(action) == MenuPosition::Settings) {
+                    screen = VisibleScreen::Settings;
+                    settingsScreen.position = 0;
+                    fullRepaint = true;
                 } else {
-                    s = STR_NO;
+                    paletteSyncFadeToBlack(0, 8, 12);
+                    return static_cast<MenuPosition>(action);
                 }
-
-                drawMenuPositionParam(113, s, position == 3);
-
-                gb.display.setColor(12);
-                gb.display.print(10, 0, KEYS_HELP_O1);
-                gb.display.print(10, 8, KEYS_HELP_O2);
             }
-
-            if (buttonPressed(BUTTON_UP)) {
-                if (position > 0)
-                    position--;
+            if (screen == VisibleScreen::Settings && buttonPressed(BUTTON_B)) {
+                screen = VisibleScreen::Main;
+                fullRepaint = true;
             }
-            if (buttonPressed(BUTTON_DOWN)) {
-                uint16_t lastPosition;
+
+            if (fullRepaint) {
+                gb.display.clear();
+                gb.display.drawImage(0, 0, backgroundImage);
+                memset(gb.tft.colorCells.paletteToLine, 0, SCREEN_HEIGHT);
+
+                text::setColor((ColorIndex)12);
                 if (screen == VisibleScreen::Main) {
-                    lastPosition = static_cast<uint16_t>(MenuPosition::Count) - 1;
+                    text::print(10, 0, KEYS_HELP_M1);
                 } else {
-                    lastPosition = 3;
-                }
-                if (position < lastPosition)
-                    position++;
-            }
-            if (buttonPressed(BUTTON_LEFT)) {
-                if (screen == VisibleScreen::Settings) {
-                    switch (position) {
-                    case 0: if (ctx.difficultyLevel > 0) ctx.difficultyLevel--; break;
-                    case 1: ctx.flags &= ~game::FLAG_SMOOTH_SCROLLING; break;
-                    case 2: ctx.flags &= ~game::FLAG_SHOW_BACKGROUND; break;
-                    case 3: ctx.flags &= ~game::FLAG_SHOW_PROFILING_INFO; break;
-                    }
-                }
-            }
-            if (buttonPressed(BUTTON_RIGHT)) {
-                if (screen == VisibleScreen::Settings) {
-                    switch (position) {
-                    case 0: if (ctx.difficultyLevel < 5) ctx.difficultyLevel++; break;
-                    case 1: ctx.flags |= game::FLAG_SMOOTH_SCROLLING; break;
-                    case 2: ctx.flags |= game::FLAG_SHOW_BACKGROUND; break;
-                    case 3: ctx.flags |= game::FLAG_SHOW_PROFILING_INFO; break;
-                    }
-                }
-            }
-            if (buttonPressed(BUTTON_A)) {
-                if (screen == VisibleScreen::Main) {
-                    if (static_cast<MenuPosition>(position) == MenuPosition::Settings) {
-                        screen = VisibleScreen::Settings;
-                        position = 0;
-                        fullRepaint = true;
-                    } else {
-                        paletteSyncFadeToBlack(0, 8, 12);
-                        return static_cast<MenuPosition>(position);
-                    }
-                }
-            }
-            if (buttonPressed(BUTTON_B)) {
-                if (screen == VisibleScreen::Settings) {
-                    screen = VisibleScreen::Main;
-                    fullRepaint = true;
+                    text::print(10, 0, KEYS_HELP_O1);
+                    text::print(10, 8, KEYS_HELP_O2);
                 }
+
+                menu::invalidate(mainScreen);
+                menu::invalidate(settingsScreen);
+                fullRepaint = false;
             }
 
+            /* Nothing is drawn until a button changes the selection or a setting */
+            menu::draw(screen == VisibleScreen::Main ? mainScreen : settingsScreen);
         }
 
     }
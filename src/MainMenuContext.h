@@ -37,6 +37,7 @@ namespace spaceshoot { namespace context { namespace mainmenu {
 #endif
         Instructions,
         Settings,
+        Benchmark,
         ReturnToBootloader,
 
         Count
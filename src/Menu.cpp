@@ -0,0 +1,166 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#include "Menu.h"
+#include "Raster.h"
+#include "Text.h"
+#include "Utils.h"
+#include <string.h>
+
+namespace spaceshoot { namespace menu {
+
+    Item action(const char* label) {
+        return { label, nullptr, 0, nullptr, 0 };
+    }
+
+    Item choice(const char* label, const char* const* options, uint8_t optionCount, uint8_t& value) {
+        return { label, options, optionCount, &value, 0 };
+    }
+
+    Item flag(const char* label, const char* const* options, uint8_t& flags, uint8_t mask) {
+        return { label, options, 2, &flags, mask };
+    }
+
+    /* Two lines above the text and two below it */
+    static const uint8_t BAR_HEIGHT = 11;
+
+    static uint8_t optionIndex(const Item& item) {
+        if (item.options == nullptr) {
+            return 0;
+        }
+        return item.mask ? ((*item.value & item.mask) ? 1 : 0) : *item.value;
+    }
+
+    void drawMenuPositionGeneric(uint8_t x, uint8_t y, uint8_t height, const char* str, ColorIndex bgColor, ColorIndex fgColor) {
+        for (size_t py = y - 2; py < y - 2 + height; py++) {
+            int k = py - y;
+            uint8_t palIndex = k < 0 ? 0 : (k > 7 ? 7 : k);
+
+            gb.tft.colorCells.paletteToLine[py] = PAL_IDX_MENUPOS + palIndex;
+        }
+
+        /* Fast lines' fill */
+        raster::fillRect(raster::framebuffer(), 0, y - 2, SCREEN_WIDTH, height, (uint8_t)bgColor);
+
+        text::setColor(fgColor);
+        text::print(x, y, str);
+    }
+
+    static void drawMenuPosition(uint8_t x, uint8_t y, uint8_t height, const char* str, bool selected) {
+        drawMenuPositionGeneric(x, y, height, str,
+                selected ? COLOR_MENUPOS_BG_ACTIVE : COLOR_MENUPOS_BG_INACTIVE,
+                selected ? COLOR_MENUPOS_FG_ACTIVE : COLOR_MENUPOS_FG_INACTIVE);
+    }
+
+    static void drawMenuPositionParam(uint8_t y, const char* str, bool selected) {
+        drawMenuPositionGeneric(SCREEN_WIDTH - 5 * strlen(str), y, BAR_HEIGHT, str,
+                selected ? COLOR_MENUPOS_BG_ACTIVE_PARAM : COLOR_MENUPOS_BG_INACTIVE,
+                selected ? COLOR_MENUPOS_FG_ACTIVE_PARAM : COLOR_MENUPOS_FG_INACTIVE);
+    }
+
+    static void drawItem(const Screen& screen, uint8_t index) {
+        const Item& item = screen.items[index];
+        const uint8_t y = screen.firstY + index * screen.spacing;
+        const bool selected = index == screen.position;
+        /* Bars closer than their height overlap, the lower one is drawn over the upper one */
+        const uint8_t height = (index + 1 < screen.count && screen.spacing < BAR_HEIGHT) ? screen.spacing : BAR_HEIGHT;
+
+        if (screen.layout == Layout::Centered) {
+            drawMenuPosition(SCREEN_WIDTH / 2 - 5 * strlen(item.label) / 2, y, height, item.label, selected);
+        } else {
+            drawMenuPosition(0, y, height, item.label, selected);
+        }
+
+        if (item.options != nullptr) {
+            drawMenuPositionParam(y + 11, item.options[optionIndex(item)], selected);
+        }
+    }
+
+    void init(Screen& screen, Layout layout, uint8_t firstY, uint8_t spacing) {
+        screen.count = 0;
+        screen.layout = layout;
+        screen.firstY = firstY;
+        screen.spacing = spacing;
+        screen.position = 0;
+        screen.drawn = false;
+    }
+
+    void add(Screen& screen, const Item& item) {
+        if (screen.count < MAX_ITEMS) {
+            screen.items[screen.count++] = item;
+        }
+    }
+
+    int8_t update(Screen& screen) {
+        Item& item = screen.items[screen.position];
+
+        if (buttonPressed(BUTTON_UP)) {
+            if (screen.position > 0)
+                screen.position--;
+        }
+        if (buttonPressed(BUTTON_DOWN)) {
+            if (screen.position + 1 < screen.count)
+                screen.position++;
+        }
+        if (buttonPressed(BUTTON_LEFT) && item.options != nullptr) {
+            if (item.mask) {
+                *item.value &= ~item.mask;
+            } else if (*item.value > 0) {
+                (*item.value)--;
+            }
+        }
+        if (buttonPressed(BUTTON_RIGHT) && item.options != nullptr) {
+            if (item.mask) {
+                *item.value |= item.mask;
+            } else if (*item.value + 1 < item.optionCount) {
+                (*item.value)++;
+            }
+        }
+        if (buttonPressed(BUTTON_A) && item.options == nullptr) {
+            return screen.position;
+        }
+        return NO_ACTION;
+    }
+
+    void invalidate(Screen& screen) {
+        screen.drawn = false;
+    }
+
+    void draw(Screen& screen) {
+        text::setFont(text::FONT_4X7);
+        text::setFontSize(1, 1);
+
+        for (uint8_t ix = 0; ix < screen.count; ix++) {
+            const uint8_t value = optionIndex(screen.items[ix]);
+            const bool selectionChanged = (ix == screen.position) != (ix == screen.shownPosition);
+
+            if (!screen.drawn || selectionChanged || value != screen.shownValues[ix]) {
+                drawItem(screen, ix);
+                screen.shownValues[ix] = value;
+            }
+        }
+
+        screen.shownPosition = screen.position;
+        screen.drawn = true;
+    }
+
+}} // namespace spaceshoot::menu
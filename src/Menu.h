@@ -0,0 +1,93 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#ifndef SST_MENU_H
+#define SST_MENU_H
+
+#include "Configuration.h"
+#include <stdint.h>
+
+/* Menus described as a list of items, each one either an action or a setting bound to a variable. What is on
+ * the screen is remembered, so that draw() only repaints the items whose selection or value has changed and
+ * does nothing at all while the menu is left alone. */
+namespace spaceshoot { namespace menu {
+
+    const size_t MAX_ITEMS = 8;
+    const int8_t NO_ACTION = -1;
+
+    /* The bars use the palettes from PAL_IDX_MENUPOS to PAL_IDX_MENUPOS + 7, for a gradient along each item */
+    const uint8_t PAL_IDX_MENUPOS = 1;
+    const ColorIndex COLOR_MENUPOS_BG_INACTIVE = (ColorIndex)0;
+    const ColorIndex COLOR_MENUPOS_BG_ACTIVE = (ColorIndex)1;
+    const ColorIndex COLOR_MENUPOS_BG_ACTIVE_PARAM = (ColorIndex)2;
+    const ColorIndex COLOR_MENUPOS_FG_INACTIVE = (ColorIndex)3;
+    const ColorIndex COLOR_MENUPOS_FG_ACTIVE = (ColorIndex)4;
+    const ColorIndex COLOR_MENUPOS_FG_ACTIVE_PARAM = (ColorIndex)5;
+
+    struct Item {
+        const char* label;
+        const char* const* options;     /* nullptr for an action */
+        uint8_t optionCount;
+        uint8_t* value;                 /* The index of the option shown, or the flags holding `mask` */
+        uint8_t mask;                   /* Non-zero for a flag, shown as options[0] when clear, options[1] when set */
+    };
+
+    Item action(const char* label);
+    Item choice(const char* label, const char* const* options, uint8_t optionCount, uint8_t& value);
+    Item flag(const char* label, const char* const* options, uint8_t& flags, uint8_t mask);
+
+    enum struct Layout : uint8_t {
+        Centered,       /* One bar per item, the label centered */
+        Settings        /* Two bars per item, the label on the left and the value below it on the right */
+    };
+
+    struct Screen {
+        Item items[MAX_ITEMS];
+        uint8_t count;
+        Layout layout;
+        uint8_t firstY;
+        uint8_t spacing;
+        uint8_t position;
+
+        /* What has been drawn */
+        bool drawn;
+        uint8_t shownPosition;
+        uint8_t shownValues[MAX_ITEMS];
+    };
+
+    void init(Screen& screen, Layout layout, uint8_t firstY, uint8_t spacing);
+    void add(Screen& screen, const Item& item);
+
+    /* Handles the buttons: up and down move the selection, left and right change the selected setting.
+     * Returns the index of the action item confirmed with A, or NO_ACTION. */
+    int8_t update(Screen& screen);
+
+    /* One bar of `height` lines with the text at (x, y), setting the line palettes for the gradient */
+    void drawMenuPositionGeneric(uint8_t x, uint8_t y, uint8_t height, const char* str, ColorIndex bgColor, ColorIndex fgColor);
+
+    /* Forgets what has been drawn, so that the next draw() repaints all items */
+    void invalidate(Screen& screen);
+    void draw(Screen& screen);
+
+}} // namespace spaceshoot::menu
+
+#endif // SST_MENU_H
@@ -0,0 +1,202 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#include "Microbench.h"
+#include "BenchmarkContext.h"
+#include "Menu.h"
+#include "Raster.h"
+#include "Panel.h"
+#include "Utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace spaceshoot { namespace microbench {
+
+using namespace context;
+using ElementID = tileset::ElementID;
+
+    struct Case {
+        const char* name;
+        uint16_t iterations;
+        void (*setUp)();
+        void (*step)(uint16_t ix);
+    };
+
+    static game::Context* benchCtx;
+    static uint16_t fadePalette[16];
+
+    /* Occupied cells in 1/24, like the benchmark scenarios */
+    static void fillField(uint8_t density) {
+        game::restart(*benchCtx);
+        benchmark::fillField(*benchCtx, density, false);
+    }
+
+    static void noSetUp() {
+    }
+
+    static void setUpEmptyField() { fillField(0); }
+    static void setUpQuarterField() { fillField(6); }
+    static void setUpHalfField() { fillField(12); }
+    static void setUpFullField() { fillField(24); }
+
+    static void stepClear(uint16_t) {
+        gb.display.clear();
+    }
+
+    static void stepFillScreen(uint16_t ix) {
+        raster::fillRect(raster::framebuffer(), 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, ix & 0x0F);
+    }
+
+    /* Even and odd positions alternate */
+    static void stepTile(uint16_t ix) {
+        tileset::draw(8 + (ix * 5) % 140, GAMEBOARD_Y + (ix * 3) % 95,
+                static_cast<ElementID>((uint8_t)ElementID::Debris1 + (ix & 0x07)));
+    }
+
+    static void stepGameField(uint16_t) {
+        game::drawStep(*benchCtx, game::DrawStep::GameField);
+    }
+
+    static void stepPlayer(uint16_t ix) {
+        benchCtx->playerPosition = ix % NUM_ROWS;
+        game::drawStep(*benchCtx, game::DrawStep::Player);
+    }
+
+    static void stepBackground(uint16_t) {
+        game::drawStep(*benchCtx, game::DrawStep::Background);
+    }
+
+    static void stepBorders(uint16_t ix) {
+        benchCtx->score = ix * 5;
+        game::drawStep(*benchCtx, game::DrawStep::Borders);
+    }
+
+    static void stepMenuPosition(uint16_t ix) {
+        menu::drawMenuPositionGeneric(40, 30 + (ix & 0x07) * 10, 11, "Instructions",
+                menu::COLOR_MENUPOS_BG_ACTIVE, menu::COLOR_MENUPOS_FG_ACTIVE);
+    }
+
+    static void stepPaletteFade(uint16_t ix) {
+        paletteFadeFromBlack(fadePalette, (const uint16_t*)Gamebuino_Meta::defaultColorPalette, ix % 11, 10);
+    }
+
+    /* Paced by the frames it waits for, four of them */
+    static void stepPaletteSyncFade(uint16_t) {
+        Color* saved = gb.tft.colorCells.palettes[0];
+        memcpy(fadePalette, Gamebuino_Meta::defaultColorPalette, sizeof(fadePalette));
+        gb.tft.colorCells.palettes[0] = (Color*)fadePalette;
+        paletteSyncFadeToBlack(0, 0, 4);
+        gb.tft.colorCells.palettes[0] = saved;
+    }
+
+    /* Every line through palette slot 0, which holds fadePalette */
+    static void setUpConvertFrame() {
+        memcpy(fadePalette, Gamebuino_Meta::defaultColorPalette, sizeof(fadePalette));
+        gb.tft.colorCells.palettes[0] = (Color*)fadePalette;
+        memset(gb.tft.colorCells.paletteToLine, 0, SCREEN_HEIGHT);
+    }
+
+    static void convertFrame() {
+        for (uint8_t y = 0; y < SCREEN_HEIGHT; y++) {
+            panel::convertLine(raster::framebuffer() + y * raster::LINE_BYTES,
+                    panel::lineBuffer(0) + (y % panel::BUFFER_LINES) * SCREEN_WIDTH, y);
+        }
+    }
+
+    static void stepConvertFrame(uint16_t) {
+        convertFrame();
+    }
+
+    /* The palette changes before every frame */
+    static void stepConvertFrameFading(uint16_t ix) {
+        paletteFadeFromBlack(fadePalette, (const uint16_t*)Gamebuino_Meta::defaultColorPalette, ix % 11, 10);
+        convertFrame();
+    }
+
+    static const Case CASES[] = {
+        {"clear",                   200,  noSetUp,            stepClear},
+        {"fillRect screen",         200,  noSetUp,            stepFillScreen},
+        {"tileset::draw",           2000, noSetUp,            stepTile},
+        {"drawGameField 0%",        100,  setUpEmptyField,    stepGameField},
+        {"drawGameField 25%",       100,  setUpQuarterField,  stepGameField},
+        {"drawGameField 50%",       100,  setUpHalfField,     stepGameField},
+        {"drawGameField 100%",      100,  setUpFullField,     stepGameField},
+        {"drawPlayer",              500,  noSetUp,            stepPlayer},
+        {"drawBackground",          100,  noSetUp,            stepBackground},
+        {"drawBorders",             200,  noSetUp,            stepBorders},
+        {"drawMenuPositionGeneric", 500,  noSetUp,            stepMenuPosition},
+        {"paletteFadeFromBlack",    1000, noSetUp,            stepPaletteFade},
+        {"paletteSyncFadeToBlack",  2,    noSetUp,            stepPaletteSyncFade},
+        {"convertLine frame",       200,  setUpConvertFrame,  stepConvertFrame},
+        {"convertLine fading",      200,  setUpConvertFrame,  stepConvertFrameFading},
+    };
+    const size_t NUM_CASES = sizeof(CASES) / sizeof(CASES[0]);
+    static_assert(NUM_CASES <= MAX_RESULTS);
+
+    size_t run(game::Context& ctx, Result* results) {
+        benchCtx = &ctx;
+        Color* savedPalette = gb.tft.colorCells.palettes[0];
+        uint8_t savedPaletteToLine[SCREEN_HEIGHT];
+        memcpy(savedPaletteToLine, gb.tft.colorCells.paletteToLine, SCREEN_HEIGHT);
+
+        game::restart(ctx);
+        game::beginDrawSteps();
+
+        for (size_t ix = 0; ix < NUM_CASES; ix++) {
+            const Case& bench = CASES[ix];
+
+            srand(benchmark::RANDOM_SEED);
+            bench.setUp();
+            bench.step(0);
+
+            uint32_t start = micros();
+            for (uint16_t iteration = 0; iteration < bench.iterations; iteration++) {
+                bench.step(iteration);
+            }
+            results[ix].totalMicros = micros() - start;
+            results[ix].name = bench.name;
+            results[ix].iterations = bench.iterations;
+        }
+
+        gb.tft.colorCells.palettes[0] = savedPalette;
+        memcpy(gb.tft.colorCells.paletteToLine, savedPaletteToLine, SCREEN_HEIGHT);
+        game::restart(ctx);
+        return NUM_CASES;
+    }
+
+    uint32_t nanosPerIteration(const Result& result) {
+        return result.iterations ? (uint32_t)((uint64_t)result.totalMicros * 1000 / result.iterations) : 0;
+    }
+
+    void formatCsv(char* dest, size_t size, const Result& result) {
+#ifdef F_CPU
+        snprintf(dest, size, "%s,%u,%lu,%lu,%lu", result.name, (unsigned int)result.iterations,
+                (unsigned long)result.totalMicros, (unsigned long)nanosPerIteration(result),
+                (unsigned long)((uint64_t)result.totalMicros * (F_CPU / 1000000) / (result.iterations ? result.iterations : 1)));
+#else
+        snprintf(dest, size, "%s,%u,%lu,%lu,", result.name, (unsigned int)result.iterations,
+                (unsigned long)result.totalMicros, (unsigned long)nanosPerIteration(result));
+#endif
+    }
+
+}} // namespace spaceshoot::microbench
@@ -0,0 +1,54 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#ifndef SST_MICROBENCH_H
+#define SST_MICROBENCH_H
+
+#include "GameContext.h"
+#include "Gamebuino-Meta-ADTCRV.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/* Repeatable timings of the drawing hot paths, one call at a time: each case runs once to warm up, then a
+ * fixed number of iterations is timed as a whole. The random generator is reseeded for every case. */
+namespace spaceshoot { namespace microbench {
+
+    const size_t MAX_RESULTS = 16;
+
+    struct Result {
+        const char* name;
+        uint16_t iterations;
+        uint32_t totalMicros;
+    };
+
+    /* Runs all cases, leaving the framebuffer and the game context dirty. Returns the number of results. */
+    size_t run(context::game::Context& ctx, Result* results);
+
+    /* Results as CSV lines; the cycle count is an estimate from the CPU clock, left empty without F_CPU */
+    const char CSV_HEADER[] = "name,iterations,total_us,ns_per_iteration,cycles_per_iteration";
+    void formatCsv(char* dest, size_t size, const Result& result);
+
+    uint32_t nanosPerIteration(const Result& result);
+
+}} // namespace spaceshoot::microbench
+
+#endif // SST_MICROBENCH_H
@@ -0,0 +1,193 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#include "Panel.h"
+#include "Raster.h"
+#include "Utils.h"
+#include "Gamebuino-Meta-ADTCRV.h"
+#include <SPI.h>
+#include <string.h>
+
+namespace Gamebuino_Meta {
+    /* Free DMA descriptors of the display driver, all of them are free once a transfer is done */
+    extern volatile uint32_t dma_desc_free_count;
+}
+
+namespace spaceshoot { namespace panel {
+
+    const uint32_t DMA_DESC_COUNT = 3;
+
+    static SPISettings tftSettings(24000000, MSBFIRST, SPI_MODE0);
+
+    /* Pixel pairs are stored as words */
+    alignas(4) static uint16_t buffers[2][BUFFER_LINES * SCREEN_WIDTH];
+    static bool transferPending;
+
+    /* Of the pixels and the palette of every line, as last sent */
+    static uint32_t lineHashes[SCREEN_HEIGHT];
+    static bool lineHashesValid;
+
+    uint16_t* lineBuffer(uint8_t index) {
+        return buffers[index];
+    }
+
+    /* One framebuffer byte to both its pixels, as a single word (little endian: the left pixel goes first) */
+    struct PairTable {
+        bool valid;
+        /* The palette it has been built from */
+        uint16_t colors[16];
+        uint32_t pairs[256];
+    };
+
+    /* Only the first palette slots get a table, the others are used by a few lines each (the HUD bars, the menu
+     * positions) and are converted pixel by pixel */
+    const uint8_t PAIR_TABLE_SLOTS = 2;
+    static PairTable pairTables[PAIR_TABLE_SLOTS];
+
+    const size_t RAM_USED = sizeof(buffers) + sizeof(lineHashes) + sizeof(pairTables);
+
+    static inline const uint16_t* linePalette(uint8_t y) {
+        return reinterpret_cast<const uint16_t*>(gb.tft.colorCells.palettes[gb.tft.colorCells.paletteToLine[y]]);
+    }
+
+    static inline void swapColors(const uint16_t* palette, uint16_t* swapped) {
+        for (uint8_t ix = 0; ix < 16; ix++) {
+            swapped[ix] = (palette[ix] >> 8) | (palette[ix] << 8);
+        }
+    }
+
+    /* Rebuilt whenever the contents of the palette change, as during the fades */
+    static const uint32_t* pairTable(uint8_t slot, const uint16_t* palette) {
+        PairTable& table = pairTables[slot];
+        if (!table.valid || memcmp(table.colors, palette, sizeof(table.colors)) != 0) {
+            memcpy(table.colors, palette, sizeof(table.colors));
+            uint16_t swapped[16];
+            swapColors(palette, swapped);
+            uint32_t* pair = table.pairs;
+            for (uint8_t left = 0; left < 16; left++) {
+                for (uint8_t right = 0; right < 16; right++) {
+                    *pair++ = swapped[left] | (static_cast<uint32_t>(swapped[right]) << 16);
+                }
+            }
+            table.valid = true;
+        }
+        return table.pairs;
+    }
+
+    void convertLine(const uint8_t* src, uint16_t* dest, uint8_t y) {
+        const uint8_t slot = gb.tft.colorCells.paletteToLine[y];
+        const uint16_t* palette = linePalette(y);
+
+        if (slot < PAIR_TABLE_SLOTS) {
+            const uint32_t* pairs = pairTable(slot, palette);
+            uint32_t* destPairs = reinterpret_cast<uint32_t*>(dest);
+            for (size_t ix = 0; ix < raster::LINE_BYTES; ix++) {
+                destPairs[ix] = pairs[src[ix]];
+            }
+            return;
+        }
+
+        uint16_t swapped[16];
+        swapColors(palette, swapped);
+        for (size_t ix = 0; ix < raster::LINE_BYTES; ix++) {
+            *dest++ = swapped[src[ix] >> 4];
+            *dest++ = swapped[src[ix] & 0x0F];
+        }
+    }
+
+    void sendLines(uint16_t* buffer, uint8_t y, uint8_t h) {
+        waitForTransfer();
+        SPI.beginTransaction(tftSettings);
+        gb.tft.setAddrWindow(0, y, SCREEN_WIDTH - 1, y + h - 1);
+        gb.tft.dataMode();
+        gb.tft.sendBuffer(buffer, h * SCREEN_WIDTH);
+        transferPending = true;
+    }
+
+    void waitForTransfer() {
+        if (transferPending) {
+            while (Gamebuino_Meta::dma_desc_free_count < DMA_DESC_COUNT);
+            gb.tft.idleMode();
+            SPI.endTransaction();
+            transferPending = false;
+        }
+    }
+
+    /* FNV-1a, a word at a time */
+    static uint32_t hashLine(const uint8_t* line, const uint16_t* palette) {
+        const uint32_t hash = hashFnv1a(FNV_OFFSET, reinterpret_cast<const uint32_t*>(line), raster::LINE_BYTES / 4);
+        return hashFnv1a(hash, reinterpret_cast<const uint32_t*>(palette), 16 / 2);
+    }
+
+    static_assert(raster::LINE_BYTES % 4 == 0);
+
+    /* Consecutive changed lines go out together, up to a whole buffer at a time */
+    static void sendChangedLines(const uint8_t* framebuffer) {
+        uint8_t buffer = 0;
+        uint8_t first = 0;
+        uint8_t count = 0;
+
+        for (uint8_t y = 0; y < SCREEN_HEIGHT; y++) {
+            const uint8_t* line = framebuffer + y * raster::LINE_BYTES;
+            const uint32_t hash = hashLine(line, linePalette(y));
+            if (lineHashesValid && hash == lineHashes[y]) {
+                continue;
+            }
+            lineHashes[y] = hash;
+
+            if (count > 0 && (first + count != y || count == BUFFER_LINES)) {
+                sendLines(buffers[buffer], first, count);
+                buffer ^= 0x01;
+                count = 0;
+            }
+            if (count == 0) {
+                first = y;
+            }
+            convertLine(line, buffers[buffer] + count * SCREEN_WIDTH, y);
+            count++;
+        }
+
+        if (count > 0) {
+            sendLines(buffers[buffer], first, count);
+        }
+        waitForTransfer();
+        lineHashesValid = true;
+    }
+
+    void update() {
+        uint16_t* framebuffer = gb.display._buffer;
+        if (framebuffer == nullptr || gb.display.colorMode != ColorMode::index || !gb.tft.colorCells.enabled) {
+            /* The library sends the whole picture, what has been sent before does not matter any more */
+            lineHashesValid = false;
+            while (!gb.update()) ;
+            return;
+        }
+
+        sendChangedLines(reinterpret_cast<const uint8_t*>(framebuffer));
+
+        /* gb.update() only sends gb.display while it has a buffer, as with the strip renderer */
+        gb.display._buffer = nullptr;
+        while (!gb.update()) ;
+        gb.display._buffer = framebuffer;
+    }
+
+}} // namespace spaceshoot::panel
@@ -0,0 +1,55 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#ifndef SST_PANEL_H
+#define SST_PANEL_H
+
+#include "Configuration.h"
+#include <stdint.h>
+
+/* Transfers to the display panel, which keeps what it has been sent until it is overwritten. Lines go out in
+ * RGB565, big endian, converted through their colorCells palettes. */
+namespace spaceshoot { namespace panel {
+
+    const size_t BUFFER_LINES = 8;
+
+    /* Two buffers of BUFFER_LINES converted lines, one can be filled while the other one is being sent */
+    uint16_t* lineBuffer(uint8_t index);
+
+    /* Static memory of the module in every mode: the line buffers, the line hashes and the pair tables */
+    extern const size_t RAM_USED;
+
+    /* One line of the indexed framebuffer, for line y of the panel; dest has to be word aligned */
+    void convertLine(const uint8_t* src, uint16_t* dest, uint8_t y);
+    /* Starts sending h lines from y on, once the previous transfer is done. The buffer has to stay untouched
+     * until waitForTransfer() returns. */
+    void sendLines(uint16_t* buffer, uint8_t y, uint8_t h);
+    void waitForTransfer();
+
+    /* Ends the frame, as processEvents() did. With an indexed framebuffer and colorCells enabled, only the lines
+     * that changed since the previous frame, in their pixels or in their palette, are sent; otherwise gb.update()
+     * sends the whole picture. */
+    void update();
+
+}} // namespace spaceshoot::panel
+
+#endif // SST_PANEL_H
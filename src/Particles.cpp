@@ -0,0 +1,196 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#include "Particles.h"
+#include "Configuration.h"
+#include "Raster.h"
+#include "Gamebuino-Meta-ADTCRV.h"
+
+namespace spaceshoot { namespace particles {
+
+    enum struct Ramp: uint8_t {
+        Spark, Shard, Flash
+    };
+
+    /* Tileset palette indices, from the oldest particle to the freshest one */
+    static const uint8_t RAMPS[][4] = {
+        /* Spark */ {1, 7, 11, 12},
+        /* Shard */ {13, 14, 7, 11},
+        /* Flash */ {2, 15, 10, 12},
+    };
+
+    /* Unit circle in 1/16 pixel units, used for the ship explosion */
+    static const int8_t DIRECTIONS[16][2] = {
+        { 16,   0}, { 15,   6}, { 11,  11}, {  6,  15},
+        {  0,  16}, { -6,  15}, {-11,  11}, {-15,   6},
+        {-16,   0}, {-15,  -6}, {-11, -11}, { -6, -15},
+        {  0, -16}, {  6, -15}, { 11, -11}, { 15,  -6},
+    };
+
+    const int16_t FIELD_TOP = GAMEBOARD_Y;
+    const int16_t FIELD_BOTTOM = GAMEBOARD_Y + NUM_ROWS * BLOCK_HEIGHT;
+
+    /* Structure of arrays, indexed by slot number */
+    static int16_t posX[POOL_SIZE];
+    static int16_t posY[POOL_SIZE];
+    static int8_t velX[POOL_SIZE];
+    static int8_t velY[POOL_SIZE];
+    static uint8_t life[POOL_SIZE];
+    static Ramp ramp[POOL_SIZE];
+
+    /* Stack of unused slots */
+    static uint8_t freeList[POOL_SIZE];
+    static uint8_t freeCount;
+
+    /* Dense list of used slots, iterated by updateAndDraw() */
+    static uint8_t active[POOL_SIZE];
+    static uint8_t activeCount;
+
+    static uint8_t spawnedThisFrame;
+
+    /* Private generator, so that the effects do not alter the sequence of rand() used by the game field */
+    static uint16_t seed = 0xACE1;
+
+    static inline uint16_t nextRandom() {
+        seed ^= seed << 7;
+        seed ^= seed >> 9;
+        seed ^= seed << 8;
+        return seed;
+    }
+
+    static_assert(POOL_SIZE <= 256);
+
+    void reset() {
+        for (size_t ix = 0; ix < POOL_SIZE; ix++) {
+            freeList[ix] = POOL_SIZE - 1 - ix;
+        }
+        freeCount = POOL_SIZE;
+        activeCount = 0;
+        spawnedThisFrame = 0;
+    }
+
+    static bool spawn(int16_t x, int16_t y, int8_t vx, int8_t vy, uint8_t lifetime, Ramp r) {
+        if (freeCount == 0 || spawnedThisFrame >= MAX_SPAWNS_PER_FRAME) {
+            return false;
+        }
+        uint8_t slot = freeList[--freeCount];
+        posX[slot] = x << FIXED_SHIFT;
+        posY[slot] = y << FIXED_SHIFT;
+        velX[slot] = vx;
+        velY[slot] = vy;
+        life[slot] = lifetime;
+        ramp[slot] = r;
+        active[activeCount++] = slot;
+        spawnedThisFrame++;
+        return true;
+    }
+
+    void spawnHitSparks(int16_t x, int16_t y) {
+        for (uint8_t ix = 0; ix < 4; ix++) {
+            uint16_t r = nextRandom();
+            int8_t vx = 4 + (r & 0x0F);
+            int8_t vy = static_cast<int8_t>((r >> 4) & 0x1F) - 16;
+            spawn(x, y, vx, vy, 6 + ((r >> 9) & 0x07), Ramp::Spark);
+        }
+    }
+
+    void spawnShipExplosion(int16_t x, int16_t y) {
+        for (uint8_t ix = 0; ix < 16; ix++) {
+            uint16_t r = nextRandom();
+            uint8_t speed = 1 + (r & 0x01);
+            spawn(x, y, DIRECTIONS[ix][0] * speed / 2, DIRECTIONS[ix][1] * speed / 2, 10 + ((r >> 1) & 0x07), Ramp::Shard);
+        }
+    }
+
+    void spawnSalvoFlash(int16_t x, int16_t y) {
+        spawn(x, y, 40, 0, 4, Ramp::Flash);
+    }
+
+    static void drawPixel(int16_t x, int16_t y, uint8_t color) {
+        raster::setPixel(raster::framebuffer() + y * raster::LINE_BYTES, x, color);
+    }
+
+    void updateAndDraw() {
+        updateAndDraw(drawPixel);
+    }
+
+    void updateAndDraw(PixelCallback plot) {
+        size_t ix = 0;
+
+        while (ix < activeCount) {
+            uint8_t slot = active[ix];
+
+            posX[slot] += velX[slot];
+            posY[slot] += velY[slot];
+            int16_t x = posX[slot] >> FIXED_SHIFT;
+            int16_t y = posY[slot] >> FIXED_SHIFT;
+
+            if (--life[slot] == 0 || x < 0 || x >= (int16_t)SCREEN_WIDTH || y < FIELD_TOP || y >= FIELD_BOTTOM) {
+                /* Return the slot to the free list, the last active one takes its place */
+                freeList[freeCount++] = slot;
+                active[ix] = active[--activeCount];
+                continue;
+            }
+
+            uint8_t age = life[slot] >> 2;
+            plot(x, y, RAMPS[static_cast<uint8_t>(ramp[slot])][age > 3 ? 3 : age]);
+            ix++;
+        }
+
+        spawnedThisFrame = 0;
+    }
+
+    size_t count() {
+        return activeCount;
+    }
+
+    void getPosition(size_t index, int16_t& x, int16_t& y) {
+        uint8_t slot = active[index];
+        x = posX[slot] >> FIXED_SHIFT;
+        y = posY[slot] >> FIXED_SHIFT;
+    }
+
+    void saturate() {
+        while (freeCount > 0) {
+            uint16_t r = nextRandom();
+            int16_t x = 8 + (r & 0x7F);
+            int16_t y = FIELD_TOP + (r >> 7) % (FIELD_BOTTOM - FIELD_TOP - 8);
+            /* Bypass the per-frame spawn budget */
+            spawnedThisFrame = 0;
+            spawn(x, y, 1, 1, 0xFF, Ramp::Shard);
+        }
+        spawnedThisFrame = 0;
+    }
+
+    uint32_t benchmarkFullPool(uint16_t iterations) {
+        uint32_t total = 0;
+        for (uint16_t ix = 0; ix < iterations; ix++) {
+            saturate();
+            uint32_t start = micros();
+            updateAndDraw();
+            total += micros() - start;
+        }
+        reset();
+        return iterations ? total / iterations : 0;
+    }
+
+}} // namespace spaceshoot::particles
@@ -0,0 +1,60 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#ifndef SST_PARTICLES_H
+#define SST_PARTICLES_H
+
+#include "Configuration.h"
+#include <stdint.h>
+
+namespace spaceshoot { namespace particles {
+
+    /* Hard cap on the number of live particles; updateAndDraw() never touches more than that per frame */
+    const size_t POOL_SIZE = 64;
+    /* Spawn budget per frame, so that a salvo hitting every row cannot flush the whole pool at once */
+    const size_t MAX_SPAWNS_PER_FRAME = 24;
+
+    /* Positions are 12.4 fixed point, velocities are in 1/16 pixel per frame */
+    const uint8_t FIXED_SHIFT = 4;
+
+    void reset();
+
+    void spawnHitSparks(int16_t x, int16_t y);
+    void spawnShipExplosion(int16_t x, int16_t y);
+    void spawnSalvoFlash(int16_t x, int16_t y);
+
+    void updateAndDraw();
+    /* The same, but the particles are handed over to the given function instead of being drawn */
+    using PixelCallback = void (*)(int16_t x, int16_t y, uint8_t color);
+    void updateAndDraw(PixelCallback plot);
+    size_t count();
+    /* Pixel position of the index-th live particle, as drawn by the last updateAndDraw() */
+    void getPosition(size_t index, int16_t& x, int16_t& y);
+
+    /* Fills the whole pool with long-living particles (worst case for updateAndDraw) */
+    void saturate();
+    /* Returns average duration of updateAndDraw() in microseconds, measured with the pool full */
+    uint32_t benchmarkFullPool(uint16_t iterations);
+
+}} // namespace spaceshoot::particles
+
+#endif // SST_PARTICLES_H
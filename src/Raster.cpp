@@ -0,0 +1,167 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#include "Raster.h"
+#include <string.h>
+
+namespace spaceshoot { namespace raster {
+
+    static inline bool isWordAligned(const void* ptr) {
+        return (reinterpret_cast<uintptr_t>(ptr) & 0x03) == 0;
+    }
+
+    static void fillBytes(uint8_t* dest, size_t bytes, uint8_t value) {
+        while (bytes > 0 && !isWordAligned(dest)) {
+            *dest++ = value;
+            bytes--;
+        }
+
+        const uint32_t word = value * 0x01010101u;
+        uint32_t* dest32 = reinterpret_cast<uint32_t*>(dest);
+        for (; bytes >= 4; bytes -= 4) {
+            *dest32++ = word;
+        }
+
+        dest = reinterpret_cast<uint8_t*>(dest32);
+        while (bytes > 0) {
+            *dest++ = value;
+            bytes--;
+        }
+    }
+
+    void fillSpan(uint8_t* line, int16_t x, int16_t w, uint8_t color) {
+        int16_t end = x + w;
+        if (x < 0) {
+            x = 0;
+        }
+        if (end > (int16_t)SCREEN_WIDTH) {
+            end = SCREEN_WIDTH;
+        }
+        if (x >= end) {
+            return;
+        }
+
+        /* Odd head and tail pixels share their bytes with pixels outside of the span */
+        if (x & 0x01) {
+            setPixel(line, x++, color);
+        }
+        if ((end & 0x01) && x < end) {
+            setPixel(line, --end, color);
+        }
+        fillBytes(line + (x >> 1), (end - x) >> 1, color * 0x11);
+    }
+
+    void fillRect(uint8_t* buffer, int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color) {
+        int16_t end = y + h;
+        if (y < 0) {
+            y = 0;
+        }
+        if (end > (int16_t)SCREEN_HEIGHT) {
+            end = SCREEN_HEIGHT;
+        }
+
+        /* Whole lines are contiguous, so they make a single span */
+        if (x <= 0 && x + w >= (int16_t)SCREEN_WIDTH) {
+            if (y < end) {
+                fillBytes(buffer + y * LINE_BYTES, (end - y) * LINE_BYTES, color * 0x11);
+            }
+            return;
+        }
+
+        for (uint8_t* line = buffer + y * LINE_BYTES; y < end; y++, line += LINE_BYTES) {
+            fillSpan(line, x, w, color);
+        }
+    }
+
+    void drawVLine(uint8_t* buffer, int16_t x, int16_t y, int16_t h, uint8_t color) {
+        int16_t end = y + h;
+        if (x < 0 || x >= (int16_t)SCREEN_WIDTH) {
+            return;
+        }
+        if (y < 0) {
+            y = 0;
+        }
+        if (end > (int16_t)SCREEN_HEIGHT) {
+            end = SCREEN_HEIGHT;
+        }
+
+        const uint8_t keep = (x & 0x01) ? 0xF0 : 0x0F;
+        const uint8_t value = (x & 0x01) ? color : color << 4;
+        for (uint8_t* dest = buffer + y * LINE_BYTES + (x >> 1); y < end; y++, dest += LINE_BYTES) {
+            *dest = (*dest & keep) | value;
+        }
+    }
+
+    void drawPixels(uint8_t* buffer, const Pixel* pixels, size_t count) {
+        for (const Pixel* end = pixels + count; pixels < end; pixels++) {
+            if ((uint16_t)pixels->x < SCREEN_WIDTH && (uint16_t)pixels->y < SCREEN_HEIGHT) {
+                setPixel(buffer + pixels->y * LINE_BYTES, pixels->x, pixels->color);
+            }
+        }
+    }
+
+    void maskedCopy(uint8_t* dest, const uint8_t* src, const uint8_t* keep, size_t bytes) {
+        while (bytes > 0 && !isWordAligned(dest)) {
+            *dest = (*dest & *keep++) | *src++;
+            dest++;
+            bytes--;
+        }
+
+        /* The sources do not have to be aligned, memcpy() takes care of that */
+        uint32_t* dest32 = reinterpret_cast<uint32_t*>(dest);
+        for (; bytes >= 4; bytes -= 4) {
+            uint32_t s, k;
+            memcpy(&s, src, 4);
+            memcpy(&k, keep, 4);
+            *dest32 = (*dest32 & k) | s;
+            dest32++;
+            src += 4;
+            keep += 4;
+        }
+
+        dest = reinterpret_cast<uint8_t*>(dest32);
+        while (bytes > 0) {
+            *dest = (*dest & *keep++) | *src++;
+            dest++;
+            bytes--;
+        }
+    }
+
+    void moveLines(uint8_t* buffer, int16_t destY, int16_t srcY, int16_t h) {
+        const int16_t top = destY < srcY ? destY : srcY;
+        if (top < 0) {
+            destY -= top;
+            srcY -= top;
+            h += top;
+        }
+        const int16_t bottom = destY > srcY ? destY : srcY;
+        if (bottom + h > (int16_t)SCREEN_HEIGHT) {
+            h = SCREEN_HEIGHT - bottom;
+        }
+        if (h <= 0) {
+            return;
+        }
+
+        memmove(buffer + destY * LINE_BYTES, buffer + srcY * LINE_BYTES, h * LINE_BYTES);
+    }
+
+}} // namespace spaceshoot::raster
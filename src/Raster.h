@@ -0,0 +1,64 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#ifndef SST_RASTER_H
+#define SST_RASTER_H
+
+#include "Configuration.h"
+#include "Gamebuino-Meta-ADTCRV.h"
+#include <stdint.h>
+
+/* Drawing primitives for 4 bpp buffers (two pixels per byte, the left one in the upper nibble), with a line
+ * stride of SCREEN_WIDTH / 2 bytes. Spans are filled a 32-bit word (8 pixels) at a time. All primitives clip
+ * to the screen. */
+namespace spaceshoot { namespace raster {
+
+    const size_t LINE_BYTES = SCREEN_WIDTH / 2;
+
+    struct Pixel {
+        int16_t x;
+        int16_t y;
+        uint8_t color;
+    };
+
+    static inline uint8_t* framebuffer() {
+        return reinterpret_cast<uint8_t*>(gb.display._buffer);
+    }
+
+    /* No clipping, for the callers that know better */
+    static inline void setPixel(uint8_t* line, int16_t x, uint8_t color) {
+        uint8_t& dest = line[x >> 1];
+        dest = (x & 0x01) ? (dest & 0xF0) | color : (dest & 0x0F) | (color << 4);
+    }
+
+    void fillSpan(uint8_t* line, int16_t x, int16_t w, uint8_t color);
+    void fillRect(uint8_t* buffer, int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color);
+    void drawVLine(uint8_t* buffer, int16_t x, int16_t y, int16_t h, uint8_t color);
+    void drawPixels(uint8_t* buffer, const Pixel* pixels, size_t count);
+    /* dest = (dest & keep) | src, byte by byte, the keep masks select the pixels of dest to leave alone */
+    void maskedCopy(uint8_t* dest, const uint8_t* src, const uint8_t* keep, size_t bytes);
+    /* Moves h whole lines from srcY to destY, the ranges may overlap. The lines left behind are not cleared. */
+    void moveLines(uint8_t* buffer, int16_t destY, int16_t srcY, int16_t h);
+
+}} // namespace spaceshoot::raster
+
+#endif // SST_RASTER_H
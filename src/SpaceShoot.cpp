@@ -28,6 +28,7 @@
 #include "MainMenuContext.h"
 #include "TitleScreenContext.h"
 #include "InstructionsContext.h"
+#include "BenchmarkContext.h"
 
 namespace spaceshoot {
 
@@ -36,7 +37,6 @@ using GameState = context::game::GameState;
 
     const char VERSION[] = "v0.2-R726";
 
-    Image tileSet;
     context::game::Context ctx;
 
     uint8_t paletteToCell[SCREEN_HEIGHT];
@@ -51,9 +51,9 @@ using GameState = context::game::GameState;
         gb.tft.colorCells.paletteToLine = paletteToCell;
         gb.tft.colorCells.palettes = palettes;
 
-        tileset::load(tileSet);
         ctx.difficultyLevel = 2;
         ctx.flags = context::game::FLAG_SMOOTH_SCROLLING | context::game::FLAG_SHOW_BACKGROUND;
+        ctx.renderMode = context::game::RenderMode::Incremental;
     }
 
     void main() {
@@ -67,7 +67,11 @@ using GameState = context::game::GameState;
 
                 switch (menuPosition) {
                     case MenuPosition::Instructions:
-                        context::instructions::run(tileSet);
+                        context::instructions::run();
+                        continue;
+
+                    case MenuPosition::Benchmark:
+                        context::benchmark::run(ctx);
                         continue;
 
                     case MenuPosition::NewGame:
@@ -81,7 +85,7 @@ using GameState = context::game::GameState;
             }
 
             context::game::restart(ctx);
-            GameState state = context::game::run(ctx, tileSet);
+            GameState state = context::game::run(ctx);
 
             if (state == GameState::GameOverTimeout) {
                 showMenu = context::gameover::run(ctx, true);
@@ -0,0 +1,117 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#include "Sprites.h"
+#include "Gamebuino-Meta-ADTCRV.h"
+
+namespace spaceshoot { namespace sprites {
+
+    static Sprite sprites[MAX_SPRITES];
+
+    /* Sprite indices sorted by z, there are few sprites, so it is simply rebuilt on every draw */
+    static uint8_t order[MAX_SPRITES];
+
+    void reset() {
+        memset(sprites, 0, sizeof(sprites));
+    }
+
+    Sprite& get(uint8_t index) {
+        return sprites[index];
+    }
+
+    void setTile(Sprite& sprite, uint8_t index, int8_t dx, int8_t dy, tileset::ElementID id) {
+        sprite.tileDx[index] = dx;
+        sprite.tileDy[index] = dy;
+        sprite.tiles[index] = id;
+        if (index >= sprite.numTiles) {
+            sprite.numTiles = index + 1;
+        }
+    }
+
+    static void sortByZ() {
+        for (uint8_t ix = 0; ix < MAX_SPRITES; ix++) {
+            uint8_t pos = ix;
+            while (pos > 0 && sprites[order[pos - 1]].z > sprites[ix].z) {
+                order[pos] = order[pos - 1];
+                pos--;
+            }
+            order[pos] = ix;
+        }
+    }
+
+    static Box getBoundingBox(const Sprite& sprite) {
+        Box box = {0, 0, 0, 0};
+        if (!sprite.visible) {
+            return box;
+        }
+
+        int16_t x0 = INT16_MAX, y0 = INT16_MAX, x1 = INT16_MIN, y1 = INT16_MIN;
+        for (uint8_t ix = 0; ix < sprite.numTiles; ix++) {
+            if (sprite.tiles[ix] == tileset::ElementID::None) {
+                continue;
+            }
+            int16_t x = sprite.x + sprite.tileDx[ix];
+            int16_t y = sprite.y + sprite.tileDy[ix];
+            if (x < x0) x0 = x;
+            if (y < y0) y0 = y;
+            if (x + (int16_t)BLOCK_WIDTH > x1) x1 = x + BLOCK_WIDTH;
+            if (y + (int16_t)BLOCK_HEIGHT > y1) y1 = y + BLOCK_HEIGHT;
+        }
+        if (x0 < x1) {
+            box.x = x0;
+            box.y = y0;
+            box.w = x1 - x0;
+            box.h = y1 - y0;
+        }
+        return box;
+    }
+
+    void forEachTile(TileCallback callback) {
+        sortByZ();
+        for (uint8_t ox = 0; ox < MAX_SPRITES; ox++) {
+            const Sprite& sprite = sprites[order[ox]];
+            if (!sprite.visible) {
+                continue;
+            }
+            for (uint8_t ix = 0; ix < sprite.numTiles; ix++) {
+                if (sprite.tiles[ix] != tileset::ElementID::None) {
+                    callback(sprite.x + sprite.tileDx[ix], sprite.y + sprite.tileDy[ix], sprite.tiles[ix]);
+                }
+            }
+        }
+    }
+
+    static void drawTile(int16_t x, int16_t y, tileset::ElementID id) {
+        if (x >= 0 && y >= 0) {
+            tileset::draw(x, y, id);
+        }
+    }
+
+    void draw() {
+        forEachTile(drawTile);
+
+        for (uint8_t ix = 0; ix < MAX_SPRITES; ix++) {
+            sprites[ix].drawnBox = getBoundingBox(sprites[ix]);
+        }
+    }
+
+}} // namespace spaceshoot::sprites
@@ -0,0 +1,72 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#ifndef SST_SPRITES_H
+#define SST_SPRITES_H
+
+#include "Configuration.h"
+#include "Tileset.h"
+#include <stdint.h>
+
+namespace spaceshoot { namespace sprites {
+
+    const size_t MAX_SPRITES = 4;
+    const size_t MAX_SPRITE_TILES = 4;
+
+    struct Box {
+        int16_t x;
+        int16_t y;
+        int16_t w;      /* Zero for an empty box */
+        int16_t h;
+    };
+
+    /* A group of tiles placed relatively to the sprite position. ElementID::None tiles are not drawn
+     * and do not count to the bounding box. */
+    struct Sprite {
+        int16_t x;
+        int16_t y;
+        uint8_t z;      /* Sprites with higher z are drawn on top */
+        bool visible;
+        uint8_t numTiles;
+        int8_t tileDx[MAX_SPRITE_TILES];
+        int8_t tileDy[MAX_SPRITE_TILES];
+        tileset::ElementID tiles[MAX_SPRITE_TILES];
+
+        Box drawnBox;   /* Where the sprite was drawn by the last draw() */
+    };
+
+    using TileCallback = void (*)(int16_t x, int16_t y, tileset::ElementID id);
+
+    /* Hides all sprites and forgets where they were drawn */
+    void reset();
+
+    Sprite& get(uint8_t index);
+    void setTile(Sprite& sprite, uint8_t index, int8_t dx, int8_t dy, tileset::ElementID id);
+
+    /* Draws the visible sprites into the framebuffer in z order and remembers their bounding boxes */
+    void draw();
+    /* Calls the function for every tile draw() would draw, in the same order */
+    void forEachTile(TileCallback callback);
+
+}} // namespace spaceshoot::sprites
+
+#endif // SST_SPRITES_H
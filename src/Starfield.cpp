@@ -0,0 +1,214 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#include "Starfield.h"
+#include "Raster.h"
+#include "Gamebuino-Meta-ADTCRV.h"
+
+namespace spaceshoot { namespace starfield {
+
+    /* Scroll speed of a layer is 1 pixel per 2^shift frames */
+    static const uint8_t LAYER_SHIFTS[NUM_LAYERS] = {4, 3, 2};
+    /* Tileset palette indices, dimmer for the far layers */
+    static const uint8_t LAYER_COLORS[NUM_LAYERS][2] = {
+        {13, 2},
+        {14, 8},
+        {7, 15},
+    };
+
+    const uint8_t FIELD_ROWS = NUM_ROWS * BLOCK_HEIGHT;
+
+    /* Structure of arrays; each layer occupies [layerStart[l], layerStart[l + 1]) and is sorted by y */
+    static uint8_t starX[MAX_STARS];
+    static uint8_t starY[MAX_STARS];
+    static uint8_t starColor[MAX_STARS];
+    static uint8_t layerStart[NUM_LAYERS + 1];
+
+    /* State of beginRows()/drawRow() */
+    static uint8_t rowShift[NUM_LAYERS];
+    static uint8_t rowCursor[NUM_LAYERS];
+
+    static_assert(MAX_STARS <= 255);
+    static_assert(SCREEN_HEIGHT <= 256);
+
+    static inline uint8_t layerShift(uint8_t layer, uint32_t frame) {
+        return frame >> LAYER_SHIFTS[layer];
+    }
+
+    static void plotLayer(uint8_t* buffer, uint8_t layer, uint8_t shift) {
+        for (uint8_t ix = layerStart[layer]; ix < layerStart[layer + 1]; ix++) {
+            uint8_t x = starX[ix] + shift;
+            if (x < SCREEN_WIDTH) {
+                raster::setPixel(buffer + starY[ix] * raster::LINE_BYTES, x, starColor[ix]);
+            }
+        }
+    }
+
+    static void sortLayer(uint8_t layer) {
+        /* Insertion sort, the layers are small and it is done once per game */
+        for (uint8_t ix = layerStart[layer] + 1; ix < layerStart[layer + 1]; ix++) {
+            uint8_t x = starX[ix];
+            uint8_t y = starY[ix];
+            uint8_t color = starColor[ix];
+            uint8_t jx = ix;
+            while (jx > layerStart[layer] && starY[jx - 1] > y) {
+                starX[jx] = starX[jx - 1];
+                starY[jx] = starY[jx - 1];
+                starColor[jx] = starColor[jx - 1];
+                jx--;
+            }
+            starX[jx] = x;
+            starY[jx] = y;
+            starColor[jx] = color;
+        }
+    }
+
+    void init(uint16_t budgetMicros) {
+        uint8_t ix = 0;
+        for (uint8_t layer = 0; layer < NUM_LAYERS; layer++) {
+            layerStart[layer] = ix;
+            for (uint8_t n = 0; n < LAYER_STARS[layer]; n++, ix++) {
+                starX[ix] = rand() & 0xFF;
+                starY[ix] = GAMEBOARD_Y + (rand() % (FIELD_ROWS / 2)) * 2;
+                starColor[ix] = LAYER_COLORS[layer][rand() & 0x01];
+            }
+        }
+        layerStart[NUM_LAYERS] = ix;
+
+        /* Calibration: one plot at the real positions, cleared right away (the first frame is a full repaint in
+         * every renderer anyway) */
+        uint32_t elapsed = 0;
+        uint8_t* buffer = raster::framebuffer();
+        if (buffer) {
+            uint32_t start = micros();
+            for (uint8_t layer = 0; layer < NUM_LAYERS; layer++) {
+                plotLayer(buffer, layer, 0);
+            }
+            elapsed = micros() - start;
+            raster::fillRect(buffer, 0, GAMEBOARD_Y, SCREEN_WIDTH, FIELD_ROWS, 0);
+        }
+
+        /* Every layer keeps the same fraction of its stars, the dropped ones are at the end of each range */
+        uint32_t keep = elapsed > budgetMicros ? (uint32_t)budgetMicros * 256 / elapsed : 256;
+        uint8_t dest = 0;
+        for (uint8_t layer = 0; layer < NUM_LAYERS; layer++) {
+            uint8_t first = layerStart[layer];
+            uint8_t n = (LAYER_STARS[layer] * keep) >> 8;
+            memmove(starX + dest, starX + first, n);
+            memmove(starY + dest, starY + first, n);
+            memmove(starColor + dest, starColor + first, n);
+            layerStart[layer] = dest;
+            dest += n;
+            layerStart[layer + 1] = dest;
+            sortLayer(layer);
+        }
+    }
+
+    size_t count() {
+        return layerStart[NUM_LAYERS];
+    }
+
+    bool moved(uint32_t frame, uint32_t previousFrame) {
+        for (uint8_t layer = 0; layer < NUM_LAYERS; layer++) {
+            if (layerShift(layer, frame) != layerShift(layer, previousFrame)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void getPosition(size_t index, uint32_t frame, int16_t& x, int16_t& y) {
+        uint8_t layer = 0;
+        while (index >= layerStart[layer + 1]) {
+            layer++;
+        }
+        x = (uint8_t)(starX[index] + layerShift(layer, frame));
+        y = starY[index];
+    }
+
+    uint8_t getColor(size_t index) {
+        return starColor[index];
+    }
+
+    void draw(uint8_t* buffer, uint32_t frame, const uint64_t* dirtyCells, int16_t fieldLeft) {
+        if (!dirtyCells) {
+            for (uint8_t layer = 0; layer < NUM_LAYERS; layer++) {
+                plotLayer(buffer, layer, layerShift(layer, frame));
+            }
+            return;
+        }
+
+        for (uint8_t layer = 0; layer < NUM_LAYERS; layer++) {
+            const uint8_t shift = layerShift(layer, frame);
+            for (uint8_t ix = layerStart[layer]; ix < layerStart[layer + 1]; ix++) {
+                uint8_t x = starX[ix] + shift;
+                if (x >= SCREEN_WIDTH) {
+                    continue;
+                }
+                if (x >= fieldLeft) {
+                    uint8_t col = (x - fieldLeft) / BLOCK_WIDTH;
+                    uint8_t row = (starY[ix] - GAMEBOARD_Y) / BLOCK_HEIGHT;
+                    if (!(dirtyCells[row] & (static_cast<uint64_t>(1) << col))) {
+                        continue;
+                    }
+                }
+                raster::setPixel(buffer + starY[ix] * raster::LINE_BYTES, x, starColor[ix]);
+            }
+        }
+    }
+
+    void beginRows(uint32_t frame) {
+        for (uint8_t layer = 0; layer < NUM_LAYERS; layer++) {
+            rowShift[layer] = layerShift(layer, frame);
+            rowCursor[layer] = layerStart[layer];
+        }
+    }
+
+    void drawRow(uint8_t* line, uint8_t y) {
+        for (uint8_t layer = 0; layer < NUM_LAYERS; layer++) {
+            const uint8_t end = layerStart[layer + 1];
+            uint8_t ix = rowCursor[layer];
+            while (ix < end && starY[ix] < y) {
+                ix++;
+            }
+            for (; ix < end && starY[ix] == y; ix++) {
+                uint8_t x = starX[ix] + rowShift[layer];
+                if (x < SCREEN_WIDTH) {
+                    raster::setPixel(line, x, starColor[ix]);
+                }
+            }
+            rowCursor[layer] = ix;
+        }
+    }
+
+    uint32_t benchmarkDraw(uint16_t iterations) {
+        uint8_t* buffer = raster::framebuffer();
+        uint32_t total = 0;
+        for (uint16_t ix = 0; ix < iterations; ix++) {
+            uint32_t start = micros();
+            draw(buffer, ix << 4);
+            total += micros() - start;
+        }
+        return iterations ? total / iterations : 0;
+    }
+
+}} // namespace spaceshoot::starfield
@@ -0,0 +1,64 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#ifndef SST_STARFIELD_H
+#define SST_STARFIELD_H
+
+#include "Configuration.h"
+#include <stdint.h>
+
+/* Parallax background: a few layers of stars scrolling left at different speeds, behind the game field */
+namespace spaceshoot { namespace starfield {
+
+    const size_t NUM_LAYERS = 3;
+    /* Layers from the farthest (slowest, densest) to the nearest one */
+    const uint8_t LAYER_STARS[NUM_LAYERS] = {96, 64, 32};
+    const size_t MAX_STARS = 192;
+
+    /* Time the plotter may take per frame; init() drops stars evenly from all layers to stay within it */
+    const uint16_t DEFAULT_BUDGET_MICROS = 120;
+
+    /* Places the stars at random (with rand()) and measures how many of them fit in the budget */
+    void init(uint16_t budgetMicros = DEFAULT_BUDGET_MICROS);
+    size_t count();
+
+    /* Whether any layer has moved between the two frames */
+    bool moved(uint32_t frame, uint32_t previousFrame);
+    /* Position of the index-th star at the given frame; x is in 0..255, so it may lie right of the screen */
+    void getPosition(size_t index, uint32_t frame, int16_t& x, int16_t& y);
+    uint8_t getColor(size_t index);
+
+    /* Plots the stars visible at the given frame. If dirtyCells is given, only the stars left of fieldLeft
+     * and the ones in the game field cells with their bits set are plotted. */
+    void draw(uint8_t* buffer, uint32_t frame, const uint64_t* dirtyCells = nullptr, int16_t fieldLeft = 0);
+
+    /* Line by line plotting for the display list: after beginRows(), drawRow() has to be called with
+     * increasing y */
+    void beginRows(uint32_t frame);
+    void drawRow(uint8_t* line, uint8_t y);
+
+    /* Returns average duration of draw() in microseconds, for the current number of stars */
+    uint32_t benchmarkDraw(uint16_t iterations);
+
+}} // namespace spaceshoot::starfield
+
+#endif // SST_STARFIELD_H
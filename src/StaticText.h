@@ -0,0 +1,119 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#ifndef SST_STATICTEXT_H
+#define SST_STATICTEXT_H
+
+#include "Text.h"
+#include "Font4x7.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/* String literals rasterized with font4x7 at compile time, for the labels that never change:
+ *
+ *     static constexpr auto STR_FOO = text::rasterize<4>("Foo");
+ *     ...
+ *     text::setColor(color);
+ *     text::print(x, y, STR_FOO);
+ *
+ * With 4 bits per pixel every lit pixel is a 0xF nibble and the rows are blitted as they are. With 1 bit per
+ * pixel the text takes a quarter of the flash, but its rows are expanded to nibbles as they are blitted. */
+namespace spaceshoot { namespace text {
+
+    /* Compile-time index lists (the C++11 way), built by halves to keep the template recursion shallow */
+    template <size_t... I> struct IndexList {};
+
+    template <class A, class B> struct Concat;
+    template <size_t... A, size_t... B> struct Concat<IndexList<A...>, IndexList<B...>> {
+        typedef IndexList<A..., (sizeof...(A) + B)...> type;
+    };
+
+    template <size_t N> struct MakeIndexList {
+        typedef typename Concat<typename MakeIndexList<N / 2>::type, typename MakeIndexList<N - N / 2>::type>::type type;
+    };
+    template <> struct MakeIndexList<0> { typedef IndexList<> type; };
+    template <> struct MakeIndexList<1> { typedef IndexList<0> type; };
+
+    /* Whether the pixel of glyph c is lit, in a font in the Gamebuino format (a byte per column, top row in bit 0) */
+    constexpr bool glyphPixel(const uint8_t* font, uint8_t c, size_t column, size_t row) {
+        return column < font[0] && ((font[2 + c * font[0] + column] >> row) & 0x01);
+    }
+
+    template <size_t LENGTH, uint8_t BPP, uint8_t SCALE_W, uint8_t SCALE_H>
+    struct StaticText {
+        static_assert(BPP == 1 || BPP == 4);
+
+        static const uint16_t WIDTH = LENGTH * (font4x7[0] + 1) * SCALE_W;
+        static const uint8_t HEIGHT = font4x7[1];
+        static const uint8_t ROW_BYTES = (WIDTH * BPP + 7) / 8;
+
+        uint8_t data[ROW_BYTES * HEIGHT];
+    };
+
+    /* Pixel x of the text row, with every column of the glyphs repeated scaleW times */
+    constexpr bool staticTextPixel(const char* str, size_t length, uint8_t scaleW, size_t x, size_t row) {
+        return x < length * (font4x7[0] + 1) * scaleW
+                && glyphPixel(font4x7, (uint8_t)str[x / ((font4x7[0] + 1) * scaleW)], (x % ((font4x7[0] + 1) * scaleW)) / scaleW, row);
+    }
+
+    /* Bits [bit, 8) of a 1 bpp byte, the leftmost pixel in bit 7 */
+    constexpr uint8_t staticTextBits(const char* str, size_t length, uint8_t scaleW, size_t x, size_t row, uint8_t bit = 0) {
+        return bit >= 8 ? 0 : (uint8_t)((staticTextPixel(str, length, scaleW, x + bit, row) ? 0x80 >> bit : 0)
+                | staticTextBits(str, length, scaleW, x, row, bit + 1));
+    }
+
+    constexpr uint8_t staticTextByte(const char* str, size_t length, uint8_t bpp, uint8_t scaleW, size_t rowBytes, size_t index) {
+        return bpp == 1
+                ? staticTextBits(str, length, scaleW, index % rowBytes * 8, index / rowBytes)
+                : (uint8_t)((staticTextPixel(str, length, scaleW, index % rowBytes * 2, index / rowBytes) ? 0xF0 : 0)
+                        | (staticTextPixel(str, length, scaleW, index % rowBytes * 2 + 1, index / rowBytes) ? 0x0F : 0));
+    }
+
+    template <size_t LENGTH, uint8_t BPP, uint8_t SCALE_W, uint8_t SCALE_H, size_t... I>
+    constexpr StaticText<LENGTH, BPP, SCALE_W, SCALE_H> buildStaticText(const char* str, IndexList<I...>) {
+        return {{ staticTextByte(str, LENGTH, BPP, SCALE_W, StaticText<LENGTH, BPP, SCALE_W, SCALE_H>::ROW_BYTES, I)... }};
+    }
+
+    /* The string without its terminating zero; no line breaks, no wrapping */
+    template <uint8_t BPP, uint8_t SCALE_W = 1, uint8_t SCALE_H = 1, size_t N>
+    constexpr StaticText<N - 1, BPP, SCALE_W, SCALE_H> rasterize(const char (&str)[N]) {
+        return buildStaticText<N - 1, BPP, SCALE_W, SCALE_H>(str,
+                typename MakeIndexList<StaticText<N - 1, BPP, SCALE_W, SCALE_H>::ROW_BYTES * font4x7[1]>::type());
+    }
+
+    /* Draws rasterized text with the current color, lit pixels only */
+    void blit(int16_t x, int16_t y, const uint8_t* data, uint16_t width, uint8_t height, uint8_t bpp, uint8_t scaleH);
+
+    template <size_t LENGTH, uint8_t BPP, uint8_t SCALE_W, uint8_t SCALE_H>
+    inline void print(int16_t x, int16_t y, const StaticText<LENGTH, BPP, SCALE_W, SCALE_H>& text) {
+        blit(x, y, text.data, text.WIDTH, text.HEIGHT, BPP, SCALE_H);
+    }
+
+    /* x at which the text is centered on the screen */
+    template <size_t LENGTH, uint8_t BPP, uint8_t SCALE_W, uint8_t SCALE_H>
+    constexpr int16_t centered(const StaticText<LENGTH, BPP, SCALE_W, SCALE_H>&) {
+        return SCREEN_WIDTH / 2 - StaticText<LENGTH, BPP, SCALE_W, SCALE_H>::WIDTH / 2;
+    }
+
+}} // namespace spaceshoot::text
+
+#endif // SST_STATICTEXT_H
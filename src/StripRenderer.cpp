@@ -0,0 +1,68 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#include "StripRenderer.h"
+#include "DisplayList.h"
+#include "Panel.h"
+#include "Gamebuino-Meta-ADTCRV.h"
+
+namespace spaceshoot { namespace striprenderer {
+
+    static_assert(STRIP_HEIGHT <= panel::BUFFER_LINES);
+
+    static uint8_t line[SCREEN_WIDTH / 2];
+    static bool active;
+
+    void begin() {
+        if (!active) {
+            gb.display.init(0, 0, SCREEN_MODE);
+            active = true;
+        }
+    }
+
+    void end() {
+        if (active) {
+            gb.display.init(SCREEN_WIDTH, SCREEN_HEIGHT, SCREEN_MODE);
+            active = false;
+        }
+    }
+
+    void drawFrame() {
+        displaylist::beginRasterize();
+
+        for (uint8_t strip = 0; strip < SCREEN_HEIGHT / STRIP_HEIGHT; strip++) {
+            /* The other buffer may still be on its way to the display */
+            uint16_t* dest = panel::lineBuffer(strip & 0x01);
+            const uint8_t y = strip * STRIP_HEIGHT;
+
+            for (uint8_t row = 0; row < STRIP_HEIGHT; row++) {
+                displaylist::rasterizeLine(line);
+                panel::convertLine(line, dest + row * SCREEN_WIDTH, y + row);
+            }
+
+            panel::sendLines(dest, y, STRIP_HEIGHT);
+        }
+
+        panel::waitForTransfer();
+    }
+
+}} // namespace spaceshoot::striprenderer
@@ -0,0 +1,51 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#ifndef SST_STRIPRENDERER_H
+#define SST_STRIPRENDERER_H
+
+#include "Configuration.h"
+#include "Panel.h"
+#include <stdint.h>
+
+namespace spaceshoot { namespace striprenderer {
+
+    const size_t STRIP_HEIGHT = 8;
+
+    static_assert(SCREEN_HEIGHT % STRIP_HEIGHT == 0);
+
+    /* Memory given back while the framebuffer is released, less what the strip renderer needs for itself: its
+     * line, and the panel module it converts and sends the strips with, which takes its memory in every mode */
+    const size_t RAM_FREED = SCREEN_WIDTH * SCREEN_HEIGHT / 2 - SCREEN_WIDTH / 2 - panel::RAM_USED;
+
+    /* Releases the framebuffer; gb.display stays empty until end() is called */
+    void begin();
+    /* Brings back the framebuffer, with undefined contents */
+    void end();
+
+    /* Rasterizes the current display list and sends it to the screen, one strip at a time. A strip is
+     * converted to RGB565 while the previous one is still being transferred. */
+    void drawFrame();
+
+}} // namespace spaceshoot::striprenderer
+
+#endif // SST_STRIPRENDERER_H
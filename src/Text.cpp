@@ -0,0 +1,239 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#include "Text.h"
+#include "StaticText.h"
+#include "Raster.h"
+#include "Font4x7.h"
+#include "Font3x5.h"
+#include <stdarg.h>
+#include <stdio.h>
+
+namespace spaceshoot { namespace text {
+
+    static constexpr uint16_t pixelMask(const uint8_t* font, size_t c, size_t row, size_t column) {
+        return glyphPixel(font, c, column, row) ? (uint16_t)(0xF000 >> (column * 4)) : 0;
+    }
+
+    static constexpr uint16_t rowMask(const uint8_t* font, size_t c, size_t row, size_t column = 0) {
+        return column >= font[0] ? 0 : (uint16_t)(pixelMask(font, c, row, column) | rowMask(font, c, row, column + 1));
+    }
+
+    template <size_t N> struct RowTable {
+        uint16_t rows[N];
+    };
+
+    template <size_t... I>
+    static constexpr RowTable<sizeof...(I)> buildRowTable(const uint8_t* font, IndexList<I...>) {
+        return {{ rowMask(font, I / font[1], I % font[1])... }};
+    }
+
+    const size_t FONT4X7_CHARS = (sizeof(font4x7) - 2) / font4x7[0];
+    static constexpr RowTable<FONT4X7_CHARS * font4x7[1]> FONT4X7_ROWS =
+            buildRowTable(font4x7, MakeIndexList<FONT4X7_CHARS * font4x7[1]>::type());
+
+    const size_t FONT3X5_CHARS = (sizeof(font3x5) - 2) / font3x5[0];
+    static constexpr RowTable<FONT3X5_CHARS * font3x5[1]> FONT3X5_ROWS =
+            buildRowTable(font3x5, MakeIndexList<FONT3X5_CHARS * font3x5[1]>::type());
+
+    static_assert(font4x7[0] <= 4);
+    static_assert(FONT4X7_CHARS <= 256);
+    static_assert(font3x5[0] <= 4);
+    static_assert(FONT3X5_CHARS <= 256);
+
+    const Font FONT_4X7 = {font4x7[0], font4x7[1], (uint8_t)(FONT4X7_CHARS - 1), FONT4X7_ROWS.rows};
+    const Font FONT_3X5 = {font3x5[0], font3x5[1], (uint8_t)(FONT3X5_CHARS - 1), FONT3X5_ROWS.rows};
+
+    static const Font* currentFont = &FONT_4X7;
+    static uint8_t currentColor;    /* Replicated into both nibbles */
+    static uint8_t fontSizeW = 1;
+    static uint8_t fontSizeH = 1;
+    static int16_t cursorX;
+    static int16_t cursorY;
+
+    void setFormat(ColorIndex color, uint8_t sizeW, uint8_t sizeH, const Font& font) {
+        setColor(color);
+        setFontSize(sizeW, sizeH);
+        setFont(font);
+    }
+
+    void setColor(ColorIndex color) {
+        currentColor = (uint8_t)color * 0x11;
+    }
+
+    void setFontSize(uint8_t sizeW, uint8_t sizeH) {
+        fontSizeW = sizeW;
+        fontSizeH = sizeH;
+    }
+
+    void setFont(const Font& font) {
+        currentFont = &font;
+    }
+
+    /* Columns [first, first + count) of a glyph row, each one repeated fontSizeW times, as a mask
+     * aligned to the top of the word */
+    static inline uint64_t scaleRow(uint16_t row, uint8_t first, uint8_t count) {
+        if (fontSizeW == 1) {
+            return (uint64_t)(uint16_t)(row << (first * 4)) << 48;
+        }
+
+        uint64_t mask = 0;
+        for (uint8_t column = first; column < first + count; column++) {
+            uint64_t pixel = (row >> (12 - column * 4)) & 0x0F;
+            for (uint8_t ix = 0; ix < fontSizeW; ix++) {
+                mask = (mask << 4) | pixel;
+            }
+        }
+        return mask << (64 - count * fontSizeW * 4);
+    }
+
+    static void blitMask(uint8_t* line, int16_t x, uint64_t mask, uint8_t width) {
+        const int16_t firstByte = x >> 1;
+        const uint8_t bytes = (width + (x & 0x01) + 1) >> 1;
+        mask >>= (x & 0x01) * 4;
+
+        for (uint8_t ix = 0; ix < bytes; ix++) {
+            const int16_t bx = firstByte + ix;
+            const uint8_t m = mask >> (56 - ix * 8);
+            if (m && bx >= 0 && bx < (int16_t)raster::LINE_BYTES) {
+                line[bx] = (line[bx] & ~m) | (currentColor & m);
+            }
+        }
+    }
+
+    /* Two 1 bpp pixels, the left one in bit 1, as a byte of nibble masks */
+    static const uint8_t EXPAND2[4] = { 0x00, 0x0F, 0xF0, 0xFF };
+
+    /* Byte index of a rasterized row, as nibble masks whatever the depth of the text */
+    static inline uint8_t maskByte(const uint8_t* row, uint8_t bpp, uint16_t index) {
+        if (bpp == 4) {
+            return row[index];
+        }
+        return EXPAND2[(row[index >> 2] >> (6 - (index & 0x03) * 2)) & 0x03];
+    }
+
+    void blit(int16_t x, int16_t y, const uint8_t* data, uint16_t width, uint8_t height, uint8_t bpp, uint8_t scaleH) {
+        uint8_t* buffer = raster::framebuffer();
+        const uint16_t rowBytes = (width * bpp + 7) >> 3;
+        const uint16_t bytes = (width + 1) >> 1;
+        const int16_t firstByte = x >> 1;
+        const bool odd = x & 0x01;
+
+        for (uint8_t row = 0; row < height; row++) {
+            const uint8_t* src = data + row * rowBytes;
+            for (uint8_t ry = 0; ry < scaleH; ry++) {
+                const int16_t line = y + row * scaleH + ry;
+                if (line < 0 || line >= (int16_t)SCREEN_HEIGHT) {
+                    continue;
+                }
+
+                uint8_t* dest = buffer + line * raster::LINE_BYTES;
+                uint8_t carry = 0;
+                /* At an odd x the masks are shifted by a nibble, spilling into one more byte */
+                for (uint16_t ix = 0; ix < bytes + odd; ix++) {
+                    const uint8_t next = ix < bytes ? maskByte(src, bpp, ix) : 0;
+                    const uint8_t m = odd ? (uint8_t)((carry << 4) | (next >> 4)) : next;
+                    const int16_t bx = firstByte + ix;
+                    carry = next;
+                    if (m && bx >= 0 && bx < (int16_t)raster::LINE_BYTES) {
+                        dest[bx] = (dest[bx] & ~m) | (currentColor & m);
+                    }
+                }
+            }
+        }
+    }
+
+    void drawChar(int16_t x, int16_t y, char c) {
+        const Font& font = *currentFont;
+        if ((uint8_t)c > font.lastChar) {
+            return;
+        }
+
+        const uint16_t* rows = font.rows + (uint8_t)c * font.height;
+
+        /* As many columns at once as fit in the mask (shifted by a nibble for odd x) */
+        uint8_t chunk = MAX_MASK_WIDTH / fontSizeW;
+        if (chunk == 0) {
+            chunk = 1;
+        }
+
+        uint8_t* buffer = raster::framebuffer();
+        for (uint8_t row = 0; row < font.height; row++) {
+            if (!rows[row]) {
+                continue;
+            }
+            for (uint8_t first = 0; first < font.width; first += chunk) {
+                const uint8_t count = first + chunk > font.width ? font.width - first : chunk;
+                const uint64_t mask = scaleRow(rows[row], first, count);
+                if (!mask) {
+                    continue;
+                }
+                for (uint8_t sy = 0; sy < fontSizeH; sy++) {
+                    const int16_t line = y + row * fontSizeH + sy;
+                    if (line >= 0 && line < (int16_t)SCREEN_HEIGHT) {
+                        blitMask(buffer + line * raster::LINE_BYTES, x + first * fontSizeW, mask, count * fontSizeW);
+                    }
+                }
+            }
+        }
+    }
+
+    void print(const char* str) {
+        const int16_t advanceX = (currentFont->width + 1) * fontSizeW;
+        const int16_t advanceY = (currentFont->height + 1) * fontSizeH;
+
+        for (; *str; str++) {
+            if (*str == '\n') {
+                cursorX = 0;
+                cursorY += advanceY;
+                continue;
+            }
+            if (*str == '\r') {
+                continue;
+            }
+
+            drawChar(cursorX, cursorY, *str);
+            cursorX += advanceX;
+            /* Wraps as soon as the next character would not fit, like gb.display does */
+            if (cursorX > (int16_t)SCREEN_WIDTH - advanceX) {
+                cursorX = 0;
+                cursorY += advanceY;
+            }
+        }
+    }
+
+    void print(int16_t x, int16_t y, const char* str) {
+        cursorX = x;
+        cursorY = y;
+        print(str);
+    }
+
+    void printf(int16_t x, int16_t y, const char* format, ...) {
+        char str[64];
+        va_list args;
+        va_start(args, format);
+        vsnprintf(str, sizeof(str), format, args);
+        va_end(args);
+        print(x, y, str);
+    }
+
+}} // namespace spaceshoot::text
@@ -0,0 +1,62 @@
+// MIT License
+// 
+// Copyright (c) 2023 Artur Twardowski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//     AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//     SOFTWARE.
+
+#ifndef SST_TEXT_H
+#define SST_TEXT_H
+
+#include "Configuration.h"
+#include "Gamebuino-Meta-ADTCRV.h"
+#include <stdint.h>
+
+/* Text output straight into the framebuffer, drawing the same pixels as gb.display.print() with the same
+ * font, color and font size. Glyphs are kept as row masks with one 0xF nibble per lit pixel, so a whole
+ * glyph row is written with a few masked byte stores instead of being decoded pixel by pixel. */
+namespace spaceshoot { namespace text {
+
+    struct Font {
+        uint8_t width;              /* Glyph size, without the spacing */
+        uint8_t height;
+        uint8_t lastChar;
+        const uint16_t* rows;       /* height masks per character, the leftmost pixel in the top nibble */
+    };
+
+    /* Both fonts are transposed at compile time */
+    extern const Font FONT_4X7;
+    extern const Font FONT_3X5;
+
+    /* Glyph rows scaled wider than that are drawn in several pieces, each column can be at most that wide */
+    const uint8_t MAX_MASK_WIDTH = 15;
+
+    void setFormat(ColorIndex color, uint8_t sizeW, uint8_t sizeH, const Font& font);
+    void setColor(ColorIndex color);
+    void setFontSize(uint8_t sizeW, uint8_t sizeH);
+    void setFont(const Font& font);
+
+    void drawChar(int16_t x, int16_t y, char c);
+    /* Like gb.display: the text continues from the cursor, '\n' and wrapping move it to the next line */
+    void print(const char* str);
+    void print(int16_t x, int16_t y, const char* str);
+    void printf(int16_t x, int16_t y, const char* format, ...);
+
+}} // namespace spaceshoot::text
+
+#endif // SST_TEXT_H
@@ -29,35 +29,572 @@ const uint16_t palette[16] = {
     0x0000, 0x7061, 0x10f7, 0x5a60, 0x5aeb, 0x0480, 0xfacb, 0xe3a1, 
     0x9492, 0x0700, 0x9fdc, 0xff6f, 0xffff, 0x39e7, 0x8bac, 0x4adf
 };
-const uint8_t tilesetData[] = {
-    160, 5, 1, 0, 0, 0, (uint8_t)ColorMode::index, 0,
-    0x00, 0x00, 0xb3, 0xb3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0xab, 0xab, 0xca, 0xca, 0x04, 0x80, 0x00, 0x40, 0x00, 0x00, 0x13, 0x13, 
-    0xb5, 0xb5, 0x40, 0x04, 0x88, 0x00, 0x88, 0xb7, 0x88, 0x00, 0x88, 0xb7, 0x00, 0x00, 0x00, 0x70, 
-    0x00, 0x33, 0x40, 0x04, 0x88, 0x00, 0x00, 0x00, 0x0d, 0x4d, 0xdd, 0xd0, 0x04, 0x80, 0x0d, 0xd0, 
-    0x03, 0xd0, 0x0d, 0x48, 0xe4, 0x4e, 0xb3, 0x71, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x3b, 0x3b, 0x11, 0x16, 0x11, 0x61, 0x16, 0x11, 0x61, 0x11, 0x55, 0x59, 0x55, 0x95, 
-    0x59, 0x55, 0x95, 0x55, 0xba, 0xba, 0xac, 0xac, 0x47, 0xa8, 0x40, 0x30, 0x00, 0x40, 0x31, 0x31, 
-    0x5b, 0x5b, 0x80, 0x08, 0x00, 0x00, 0x00, 0x70, 0x00, 0x00, 0x00, 0x70, 0x00, 0x00, 0x00, 0x00, 
-    0x37, 0xbb, 0x80, 0x77, 0x70, 0x00, 0x88, 0x84, 0x0d, 0x4d, 0xd8, 0x80, 0x08, 0x40, 0xd8, 0x8d, 
-    0x08, 0x30, 0x48, 0x00, 0x3e, 0xe3, 0x4a, 0xc6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0xb3, 0xb3, 0x77, 0x16, 0x71, 0x67, 0x16, 0x77, 0x67, 0x71, 0x55, 0x59, 0x55, 0x95, 
-    0x59, 0x55, 0x95, 0x55, 0xab, 0xab, 0xca, 0xca, 0x7a, 0x7a, 0x03, 0x43, 0x04, 0x00, 0x17, 0x16, 
-    0x55, 0x55, 0x68, 0x88, 0x84, 0x48, 0x84, 0xc8, 0x84, 0xc8, 0x84, 0xc8, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x33, 0x68, 0xbb, 0xb7, 0x78, 0x88, 0x88, 0x0d, 0x4d, 0xd8, 0xd8, 0x04, 0x80, 0xde, 0xed, 
-    0x0e, 0x80, 0x00, 0x80, 0x43, 0x34, 0x00, 0x85, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x3b, 0x3b, 0x1b, 0x66, 0xb6, 0x61, 0x66, 0x1b, 0x61, 0xb6, 0x5b, 0xb9, 0xbb, 0x95, 
-    0xb9, 0x5b, 0x95, 0xbb, 0xba, 0xba, 0xac, 0xac, 0x47, 0xa8, 0x44, 0x04, 0x00, 0x00, 0x3b, 0x31, 
-    0x5b, 0x5b, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0x00, 0x70, 0x00, 0x00, 0x00, 0x00, 
-    0x37, 0xbb, 0x80, 0x77, 0x70, 0x00, 0x04, 0x48, 0x0d, 0x4d, 0x00, 0x8d, 0x08, 0x40, 0xd4, 0x4d, 
-    0x03, 0xe0, 0x80, 0x00, 0x4e, 0x34, 0x00, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0xb3, 0xb3, 0x11, 0x16, 0x11, 0x61, 0x16, 0x11, 0x61, 0x11, 0x55, 0x59, 0x55, 0x95, 
-    0x59, 0x55, 0x95, 0x55, 0xab, 0xab, 0xca, 0xca, 0x0a, 0x80, 0x03, 0x00, 0x04, 0x00, 0x13, 0x13, 
-    0xb5, 0xb5, 0x40, 0x04, 0x88, 0x00, 0x88, 0x00, 0x88, 0xb7, 0x88, 0xb7, 0x00, 0x70, 0x00, 0x00, 
-    0x00, 0x33, 0x40, 0x04, 0x88, 0x00, 0x00, 0x48, 0x0d, 0x4d, 0x00, 0x00, 0x88, 0x88, 0x0d, 0xd0, 
-    0x0d, 0x30, 0x08, 0xd8, 0x4e, 0x34, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+/* scripts/imconv.py resources/tileset.bmp bmp4-atlas tileset 4 5 0 35 */
+const uint8_t tilesetAtlas[35][2][5][6] = {
+    /* 0 */ {
+        {
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff}
+        },
+        {
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff}
+        }
+    },
+    /* 1 */ {
+        {
+            {0xb3, 0xb3, 0x00, 0x00, 0x00, 0xff},
+            {0x3b, 0x3b, 0x00, 0x00, 0x00, 0xff},
+            {0xb3, 0xb3, 0x00, 0x00, 0x00, 0xff},
+            {0x3b, 0x3b, 0x00, 0x00, 0x00, 0xff},
+            {0xb3, 0xb3, 0x00, 0x00, 0x00, 0xff}
+        },
+        {
+            {0x0b, 0x3b, 0x30, 0xf0, 0x00, 0x0f},
+            {0x03, 0xb3, 0xb0, 0xf0, 0x00, 0x0f},
+            {0x0b, 0x3b, 0x30, 0xf0, 0x00, 0x0f},
+            {0x03, 0xb3, 0xb0, 0xf0, 0x00, 0x0f},
+            {0x0b, 0x3b, 0x30, 0xf0, 0x00, 0x0f}
+        }
+    },
+    /* 2 */ {
+        {
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x11, 0x16, 0x00, 0x00, 0x00, 0xff},
+            {0x77, 0x16, 0x00, 0x00, 0x00, 0xff},
+            {0x1b, 0x66, 0x00, 0x00, 0x00, 0xff},
+            {0x11, 0x16, 0x00, 0x00, 0x00, 0xff}
+        },
+        {
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x01, 0x11, 0x60, 0xf0, 0x00, 0x0f},
+            {0x07, 0x71, 0x60, 0xf0, 0x00, 0x0f},
+            {0x01, 0xb6, 0x60, 0xf0, 0x00, 0x0f},
+            {0x01, 0x11, 0x60, 0xf0, 0x00, 0x0f}
+        }
+    },
+    /* 3 */ {
+        {
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x11, 0x61, 0x00, 0x00, 0x00, 0xff},
+            {0x71, 0x67, 0x00, 0x00, 0x00, 0xff},
+            {0xb6, 0x61, 0x00, 0x00, 0x00, 0xff},
+            {0x11, 0x61, 0x00, 0x00, 0x00, 0xff}
+        },
+        {
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x01, 0x16, 0x10, 0xf0, 0x00, 0x0f},
+            {0x07, 0x16, 0x70, 0xf0, 0x00, 0x0f},
+            {0x0b, 0x66, 0x10, 0xf0, 0x00, 0x0f},
+            {0x01, 0x16, 0x10, 0xf0, 0x00, 0x0f}
+        }
+    },
+    /* 4 */ {
+        {
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x16, 0x11, 0x00, 0x00, 0x00, 0xff},
+            {0x16, 0x77, 0x00, 0x00, 0x00, 0xff},
+            {0x66, 0x1b, 0x00, 0x00, 0x00, 0xff},
+            {0x16, 0x11, 0x00, 0x00, 0x00, 0xff}
+        },
+        {
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x01, 0x61, 0x10, 0xf0, 0x00, 0x0f},
+            {0x01, 0x67, 0x70, 0xf0, 0x00, 0x0f},
+            {0x06, 0x61, 0xb0, 0xf0, 0x00, 0x0f},
+            {0x01, 0x61, 0x10, 0xf0, 0x00, 0x0f}
+        }
+    },
+    /* 5 */ {
+        {
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x61, 0x11, 0x00, 0x00, 0x00, 0xff},
+            {0x67, 0x71, 0x00, 0x00, 0x00, 0xff},
+            {0x61, 0xb6, 0x00, 0x00, 0x00, 0xff},
+            {0x61, 0x11, 0x00, 0x00, 0x00, 0xff}
+        },
+        {
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x06, 0x11, 0x10, 0xf0, 0x00, 0x0f},
+            {0x06, 0x77, 0x10, 0xf0, 0x00, 0x0f},
+            {0x06, 0x1b, 0x60, 0xf0, 0x00, 0x0f},
+            {0x06, 0x11, 0x10, 0xf0, 0x00, 0x0f}
+        }
+    },
+    /* 6 */ {
+        {
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x55, 0x59, 0x00, 0x00, 0x00, 0xff},
+            {0x55, 0x59, 0x00, 0x00, 0x00, 0xff},
+            {0x5b, 0xb9, 0x00, 0x00, 0x00, 0xff},
+            {0x55, 0x59, 0x00, 0x00, 0x00, 0xff}
+        },
+        {
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x05, 0x55, 0x90, 0xf0, 0x00, 0x0f},
+            {0x05, 0x55, 0x90, 0xf0, 0x00, 0x0f},
+            {0x05, 0xbb, 0x90, 0xf0, 0x00, 0x0f},
+            {0x05, 0x55, 0x90, 0xf0, 0x00, 0x0f}
+        }
+    },
+    /* 7 */ {
+        {
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x55, 0x95, 0x00, 0x00, 0x00, 0xff},
+            {0x55, 0x95, 0x00, 0x00, 0x00, 0xff},
+            {0xbb, 0x95, 0x00, 0x00, 0x00, 0xff},
+            {0x55, 0x95, 0x00, 0x00, 0x00, 0xff}
+        },
+        {
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x05, 0x59, 0x50, 0xf0, 0x00, 0x0f},
+            {0x05, 0x59, 0x50, 0xf0, 0x00, 0x0f},
+            {0x0b, 0xb9, 0x50, 0xf0, 0x00, 0x0f},
+            {0x05, 0x59, 0x50, 0xf0, 0x00, 0x0f}
+        }
+    },
+    /* 8 */ {
+        {
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x59, 0x55, 0x00, 0x00, 0x00, 0xff},
+            {0x59, 0x55, 0x00, 0x00, 0x00, 0xff},
+            {0xb9, 0x5b, 0x00, 0x00, 0x00, 0xff},
+            {0x59, 0x55, 0x00, 0x00, 0x00, 0xff}
+        },
+        {
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x05, 0x95, 0x50, 0xf0, 0x00, 0x0f},
+            {0x05, 0x95, 0x50, 0xf0, 0x00, 0x0f},
+            {0x0b, 0x95, 0xb0, 0xf0, 0x00, 0x0f},
+            {0x05, 0x95, 0x50, 0xf0, 0x00, 0x0f}
+        }
+    },
+    /* 9 */ {
+        {
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x95, 0x55, 0x00, 0x00, 0x00, 0xff},
+            {0x95, 0x55, 0x00, 0x00, 0x00, 0xff},
+            {0x95, 0xbb, 0x00, 0x00, 0x00, 0xff},
+            {0x95, 0x55, 0x00, 0x00, 0x00, 0xff}
+        },
+        {
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x09, 0x55, 0x50, 0xf0, 0x00, 0x0f},
+            {0x09, 0x55, 0x50, 0xf0, 0x00, 0x0f},
+            {0x09, 0x5b, 0xb0, 0xf0, 0x00, 0x0f},
+            {0x09, 0x55, 0x50, 0xf0, 0x00, 0x0f}
+        }
+    },
+    /* 10 */ {
+        {
+            {0xab, 0xab, 0x00, 0x00, 0x00, 0xff},
+            {0xba, 0xba, 0x00, 0x00, 0x00, 0xff},
+            {0xab, 0xab, 0x00, 0x00, 0x00, 0xff},
+            {0xba, 0xba, 0x00, 0x00, 0x00, 0xff},
+            {0xab, 0xab, 0x00, 0x00, 0x00, 0xff}
+        },
+        {
+            {0x0a, 0xba, 0xb0, 0xf0, 0x00, 0x0f},
+            {0x0b, 0xab, 0xa0, 0xf0, 0x00, 0x0f},
+            {0x0a, 0xba, 0xb0, 0xf0, 0x00, 0x0f},
+            {0x0b, 0xab, 0xa0, 0xf0, 0x00, 0x0f},
+            {0x0a, 0xba, 0xb0, 0xf0, 0x00, 0x0f}
+        }
+    },
+    /* 11 */ {
+        {
+            {0xca, 0xca, 0x00, 0x00, 0x00, 0xff},
+            {0xac, 0xac, 0x00, 0x00, 0x00, 0xff},
+            {0xca, 0xca, 0x00, 0x00, 0x00, 0xff},
+            {0xac, 0xac, 0x00, 0x00, 0x00, 0xff},
+            {0xca, 0xca, 0x00, 0x00, 0x00, 0xff}
+        },
+        {
+            {0x0c, 0xac, 0xa0, 0xf0, 0x00, 0x0f},
+            {0x0a, 0xca, 0xc0, 0xf0, 0x00, 0x0f},
+            {0x0c, 0xac, 0xa0, 0xf0, 0x00, 0x0f},
+            {0x0a, 0xca, 0xc0, 0xf0, 0x00, 0x0f},
+            {0x0c, 0xac, 0xa0, 0xf0, 0x00, 0x0f}
+        }
+    },
+    /* 12 */ {
+        {
+            {0x04, 0x80, 0x00, 0xf0, 0x0f, 0xff},
+            {0x47, 0xa8, 0x00, 0x00, 0x00, 0xff},
+            {0x7a, 0x7a, 0x00, 0x00, 0x00, 0xff},
+            {0x47, 0xa8, 0x00, 0x00, 0x00, 0xff},
+            {0x0a, 0x80, 0x00, 0xf0, 0x0f, 0xff}
+        },
+        {
+            {0x00, 0x48, 0x00, 0xff, 0x00, 0xff},
+            {0x04, 0x7a, 0x80, 0xf0, 0x00, 0x0f},
+            {0x07, 0xa7, 0xa0, 0xf0, 0x00, 0x0f},
+            {0x04, 0x7a, 0x80, 0xf0, 0x00, 0x0f},
+            {0x00, 0xa8, 0x00, 0xff, 0x00, 0xff}
+        }
+    },
+    /* 13 */ {
+        {
+            {0x00, 0x40, 0x00, 0xff, 0x0f, 0xff},
+            {0x40, 0x30, 0x00, 0x0f, 0x0f, 0xff},
+            {0x03, 0x43, 0x00, 0xf0, 0x00, 0xff},
+            {0x44, 0x04, 0x00, 0x00, 0xf0, 0xff},
+            {0x03, 0x00, 0x00, 0xf0, 0xff, 0xff}
+        },
+        {
+            {0x00, 0x04, 0x00, 0xff, 0xf0, 0xff},
+            {0x04, 0x03, 0x00, 0xf0, 0xf0, 0xff},
+            {0x00, 0x34, 0x30, 0xff, 0x00, 0x0f},
+            {0x04, 0x40, 0x40, 0xf0, 0x0f, 0x0f},
+            {0x00, 0x30, 0x00, 0xff, 0x0f, 0xff}
+        }
+    },
+    /* 14 */ {
+        {
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x00, 0x40, 0x00, 0xff, 0x0f, 0xff},
+            {0x04, 0x00, 0x00, 0xf0, 0xff, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x04, 0x00, 0x00, 0xf0, 0xff, 0xff}
+        },
+        {
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x00, 0x04, 0x00, 0xff, 0xf0, 0xff},
+            {0x00, 0x40, 0x00, 0xff, 0x0f, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x00, 0x40, 0x00, 0xff, 0x0f, 0xff}
+        }
+    },
+    /* 15 */ {
+        {
+            {0x13, 0x13, 0x00, 0x00, 0x00, 0xff},
+            {0x31, 0x31, 0x00, 0x00, 0x00, 0xff},
+            {0x17, 0x16, 0x00, 0x00, 0x00, 0xff},
+            {0x3b, 0x31, 0x00, 0x00, 0x00, 0xff},
+            {0x13, 0x13, 0x00, 0x00, 0x00, 0xff}
+        },
+        {
+            {0x01, 0x31, 0x30, 0xf0, 0x00, 0x0f},
+            {0x03, 0x13, 0x10, 0xf0, 0x00, 0x0f},
+            {0x01, 0x71, 0x60, 0xf0, 0x00, 0x0f},
+            {0x03, 0xb3, 0x10, 0xf0, 0x00, 0x0f},
+            {0x01, 0x31, 0x30, 0xf0, 0x00, 0x0f}
+        }
+    },
+    /* 16 */ {
+        {
+            {0xb5, 0xb5, 0x00, 0x00, 0x00, 0xff},
+            {0x5b, 0x5b, 0x00, 0x00, 0x00, 0xff},
+            {0x55, 0x55, 0x00, 0x00, 0x00, 0xff},
+            {0x5b, 0x5b, 0x00, 0x00, 0x00, 0xff},
+            {0xb5, 0xb5, 0x00, 0x00, 0x00, 0xff}
+        },
+        {
+            {0x0b, 0x5b, 0x50, 0xf0, 0x00, 0x0f},
+            {0x05, 0xb5, 0xb0, 0xf0, 0x00, 0x0f},
+            {0x05, 0x55, 0x50, 0xf0, 0x00, 0x0f},
+            {0x05, 0xb5, 0xb0, 0xf0, 0x00, 0x0f},
+            {0x0b, 0x5b, 0x50, 0xf0, 0x00, 0x0f}
+        }
+    },
+    /* 17 */ {
+        {
+            {0x40, 0x04, 0x00, 0x0f, 0xf0, 0xff},
+            {0x80, 0x08, 0x00, 0x0f, 0xf0, 0xff},
+            {0x68, 0x88, 0x00, 0x00, 0x00, 0xff},
+            {0x80, 0x08, 0x00, 0x0f, 0xf0, 0xff},
+            {0x40, 0x04, 0x00, 0x0f, 0xf0, 0xff}
+        },
+        {
+            {0x04, 0x00, 0x40, 0xf0, 0xff, 0x0f},
+            {0x08, 0x00, 0x80, 0xf0, 0xff, 0x0f},
+            {0x06, 0x88, 0x80, 0xf0, 0x00, 0x0f},
+            {0x08, 0x00, 0x80, 0xf0, 0xff, 0x0f},
+            {0x04, 0x00, 0x40, 0xf0, 0xff, 0x0f}
+        }
+    },
+    /* 18 */ {
+        {
+            {0x88, 0x00, 0x00, 0x00, 0xff, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x84, 0x48, 0x00, 0x00, 0x00, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x88, 0x00, 0x00, 0x00, 0xff, 0xff}
+        },
+        {
+            {0x08, 0x80, 0x00, 0xf0, 0x0f, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x08, 0x44, 0x80, 0xf0, 0x00, 0x0f},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x08, 0x80, 0x00, 0xf0, 0x0f, 0xff}
+        }
+    },
+    /* 19 */ {
+        {
+            {0x88, 0xb7, 0x00, 0x00, 0x00, 0xff},
+            {0x00, 0x70, 0x00, 0xff, 0x0f, 0xff},
+            {0x84, 0xc8, 0x00, 0x00, 0x00, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x88, 0x00, 0x00, 0x00, 0xff, 0xff}
+        },
+        {
+            {0x08, 0x8b, 0x70, 0xf0, 0x00, 0x0f},
+            {0x00, 0x07, 0x00, 0xff, 0xf0, 0xff},
+            {0x08, 0x4c, 0x80, 0xf0, 0x00, 0x0f},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x08, 0x80, 0x00, 0xf0, 0x0f, 0xff}
+        }
+    },
+    /* 20 */ {
+        {
+            {0x88, 0x00, 0x00, 0x00, 0xff, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x84, 0xc8, 0x00, 0x00, 0x00, 0xff},
+            {0x00, 0x70, 0x00, 0xff, 0x0f, 0xff},
+            {0x88, 0xb7, 0x00, 0x00, 0x00, 0xff}
+        },
+        {
+            {0x08, 0x80, 0x00, 0xf0, 0x0f, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x08, 0x4c, 0x80, 0xf0, 0x00, 0x0f},
+            {0x00, 0x07, 0x00, 0xff, 0xf0, 0xff},
+            {0x08, 0x8b, 0x70, 0xf0, 0x00, 0x0f}
+        }
+    },
+    /* 21 */ {
+        {
+            {0x88, 0xb7, 0x00, 0x00, 0x00, 0xff},
+            {0x00, 0x70, 0x00, 0xff, 0x0f, 0xff},
+            {0x84, 0xc8, 0x00, 0x00, 0x00, 0xff},
+            {0x00, 0x70, 0x00, 0xff, 0x0f, 0xff},
+            {0x88, 0xb7, 0x00, 0x00, 0x00, 0xff}
+        },
+        {
+            {0x08, 0x8b, 0x70, 0xf0, 0x00, 0x0f},
+            {0x00, 0x07, 0x00, 0xff, 0xf0, 0xff},
+            {0x08, 0x4c, 0x80, 0xf0, 0x00, 0x0f},
+            {0x00, 0x07, 0x00, 0xff, 0xf0, 0xff},
+            {0x08, 0x8b, 0x70, 0xf0, 0x00, 0x0f}
+        }
+    },
+    /* 22 */ {
+        {
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x00, 0x70, 0x00, 0xff, 0x0f, 0xff}
+        },
+        {
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x00, 0x07, 0x00, 0xff, 0xf0, 0xff}
+        }
+    },
+    /* 23 */ {
+        {
+            {0x00, 0x70, 0x00, 0xff, 0x0f, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff}
+        },
+        {
+            {0x00, 0x07, 0x00, 0xff, 0xf0, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff}
+        }
+    },
+    /* 24 */ {
+        {
+            {0x00, 0x33, 0x00, 0xff, 0x00, 0xff},
+            {0x37, 0xbb, 0x00, 0x00, 0x00, 0xff},
+            {0x00, 0x33, 0x00, 0xff, 0x00, 0xff},
+            {0x37, 0xbb, 0x00, 0x00, 0x00, 0xff},
+            {0x00, 0x33, 0x00, 0xff, 0x00, 0xff}
+        },
+        {
+            {0x00, 0x03, 0x30, 0xff, 0xf0, 0x0f},
+            {0x03, 0x7b, 0xb0, 0xf0, 0x00, 0x0f},
+            {0x00, 0x03, 0x30, 0xff, 0xf0, 0x0f},
+            {0x03, 0x7b, 0xb0, 0xf0, 0x00, 0x0f},
+            {0x00, 0x03, 0x30, 0xff, 0xf0, 0x0f}
+        }
+    },
+    /* 25 */ {
+        {
+            {0x40, 0x04, 0x00, 0x0f, 0xf0, 0xff},
+            {0x80, 0x77, 0x00, 0x0f, 0x00, 0xff},
+            {0x68, 0xbb, 0x00, 0x00, 0x00, 0xff},
+            {0x80, 0x77, 0x00, 0x0f, 0x00, 0xff},
+            {0x40, 0x04, 0x00, 0x0f, 0xf0, 0xff}
+        },
+        {
+            {0x04, 0x00, 0x40, 0xf0, 0xff, 0x0f},
+            {0x08, 0x07, 0x70, 0xf0, 0xf0, 0x0f},
+            {0x06, 0x8b, 0xb0, 0xf0, 0x00, 0x0f},
+            {0x08, 0x07, 0x70, 0xf0, 0xf0, 0x0f},
+            {0x04, 0x00, 0x40, 0xf0, 0xff, 0x0f}
+        }
+    },
+    /* 26 */ {
+        {
+            {0x88, 0x00, 0x00, 0x00, 0xff, 0xff},
+            {0x70, 0x00, 0x00, 0x0f, 0xff, 0xff},
+            {0xb7, 0x78, 0x00, 0x00, 0x00, 0xff},
+            {0x70, 0x00, 0x00, 0x0f, 0xff, 0xff},
+            {0x88, 0x00, 0x00, 0x00, 0xff, 0xff}
+        },
+        {
+            {0x08, 0x80, 0x00, 0xf0, 0x0f, 0xff},
+            {0x07, 0x00, 0x00, 0xf0, 0xff, 0xff},
+            {0x0b, 0x77, 0x80, 0xf0, 0x00, 0x0f},
+            {0x07, 0x00, 0x00, 0xf0, 0xff, 0xff},
+            {0x08, 0x80, 0x00, 0xf0, 0x0f, 0xff}
+        }
+    },
+    /* 27 */ {
+        {
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x88, 0x84, 0x00, 0x00, 0x00, 0xff},
+            {0x88, 0x88, 0x00, 0x00, 0x00, 0xff},
+            {0x04, 0x48, 0x00, 0xf0, 0x00, 0xff},
+            {0x00, 0x48, 0x00, 0xff, 0x00, 0xff}
+        },
+        {
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff},
+            {0x08, 0x88, 0x40, 0xf0, 0x00, 0x0f},
+            {0x08, 0x88, 0x80, 0xf0, 0x00, 0x0f},
+            {0x00, 0x44, 0x80, 0xff, 0x00, 0x0f},
+            {0x00, 0x04, 0x80, 0xff, 0xf0, 0x0f}
+        }
+    },
+    /* 28 */ {
+        {
+            {0x0d, 0x4d, 0x00, 0xf0, 0x00, 0xff},
+            {0x0d, 0x4d, 0x00, 0xf0, 0x00, 0xff},
+            {0x0d, 0x4d, 0x00, 0xf0, 0x00, 0xff},
+            {0x0d, 0x4d, 0x00, 0xf0, 0x00, 0xff},
+            {0x0d, 0x4d, 0x00, 0xf0, 0x00, 0xff}
+        },
+        {
+            {0x00, 0xd4, 0xd0, 0xff, 0x00, 0x0f},
+            {0x00, 0xd4, 0xd0, 0xff, 0x00, 0x0f},
+            {0x00, 0xd4, 0xd0, 0xff, 0x00, 0x0f},
+            {0x00, 0xd4, 0xd0, 0xff, 0x00, 0x0f},
+            {0x00, 0xd4, 0xd0, 0xff, 0x00, 0x0f}
+        }
+    },
+    /* 29 */ {
+        {
+            {0xdd, 0xd0, 0x00, 0x00, 0x0f, 0xff},
+            {0xd8, 0x80, 0x00, 0x00, 0x0f, 0xff},
+            {0xd8, 0xd8, 0x00, 0x00, 0x00, 0xff},
+            {0x00, 0x8d, 0x00, 0xff, 0x00, 0xff},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff}
+        },
+        {
+            {0x0d, 0xdd, 0x00, 0xf0, 0x00, 0xff},
+            {0x0d, 0x88, 0x00, 0xf0, 0x00, 0xff},
+            {0x0d, 0x8d, 0x80, 0xf0, 0x00, 0x0f},
+            {0x00, 0x08, 0xd0, 0xff, 0xf0, 0x0f},
+            {0x00, 0x00, 0x00, 0xff, 0xff, 0xff}
+        }
+    },
+    /* 30 */ {
+        {
+            {0x04, 0x80, 0x00, 0xf0, 0x0f, 0xff},
+            {0x08, 0x40, 0x00, 0xf0, 0x0f, 0xff},
+            {0x04, 0x80, 0x00, 0xf0, 0x0f, 0xff},
+            {0x08, 0x40, 0x00, 0xf0, 0x0f, 0xff},
+            {0x88, 0x88, 0x00, 0x00, 0x00, 0xff}
+        },
+        {
+            {0x00, 0x48, 0x00, 0xff, 0x00, 0xff},
+            {0x00, 0x84, 0x00, 0xff, 0x00, 0xff},
+            {0x00, 0x48, 0x00, 0xff, 0x00, 0xff},
+            {0x00, 0x84, 0x00, 0xff, 0x00, 0xff},
+            {0x08, 0x88, 0x80, 0xf0, 0x00, 0x0f}
+        }
+    },
+    /* 31 */ {
+        {
+            {0x0d, 0xd0, 0x00, 0xf0, 0x0f, 0xff},
+            {0xd8, 0x8d, 0x00, 0x00, 0x00, 0xff},
+            {0xde, 0xed, 0x00, 0x00, 0x00, 0xff},
+            {0xd4, 0x4d, 0x00, 0x00, 0x00, 0xff},
+            {0x0d, 0xd0, 0x00, 0xf0, 0x0f, 0xff}
+        },
+        {
+            {0x00, 0xdd, 0x00, 0xff, 0x00, 0xff},
+            {0x0d, 0x88, 0xd0, 0xf0, 0x00, 0x0f},
+            {0x0d, 0xee, 0xd0, 0xf0, 0x00, 0x0f},
+            {0x0d, 0x44, 0xd0, 0xf0, 0x00, 0x0f},
+            {0x00, 0xdd, 0x00, 0xff, 0x00, 0xff}
+        }
+    },
+    /* 32 */ {
+        {
+            {0x03, 0xd0, 0x00, 0xf0, 0x0f, 0xff},
+            {0x08, 0x30, 0x00, 0xf0, 0x0f, 0xff},
+            {0x0e, 0x80, 0x00, 0xf0, 0x0f, 0xff},
+            {0x03, 0xe0, 0x00, 0xf0, 0x0f, 0xff},
+            {0x0d, 0x30, 0x00, 0xf0, 0x0f, 0xff}
+        },
+        {
+            {0x00, 0x3d, 0x00, 0xff, 0x00, 0xff},
+            {0x00, 0x83, 0x00, 0xff, 0x00, 0xff},
+            {0x00, 0xe8, 0x00, 0xff, 0x00, 0xff},
+            {0x00, 0x3e, 0x00, 0xff, 0x00, 0xff},
+            {0x00, 0xd3, 0x00, 0xff, 0x00, 0xff}
+        }
+    },
+    /* 33 */ {
+        {
+            {0x0d, 0x48, 0x00, 0xf0, 0x00, 0xff},
+            {0x48, 0x00, 0x00, 0x00, 0xff, 0xff},
+            {0x00, 0x80, 0x00, 0xff, 0x0f, 0xff},
+            {0x80, 0x00, 0x00, 0x0f, 0xff, 0xff},
+            {0x08, 0xd8, 0x00, 0xf0, 0x00, 0xff}
+        },
+        {
+            {0x00, 0xd4, 0x80, 0xff, 0x00, 0x0f},
+            {0x04, 0x80, 0x00, 0xf0, 0x0f, 0xff},
+            {0x00, 0x08, 0x00, 0xff, 0xf0, 0xff},
+            {0x08, 0x00, 0x00, 0xf0, 0xff, 0xff},
+            {0x00, 0x8d, 0x80, 0xff, 0x00, 0x0f}
+        }
+    },
+    /* 34 */ {
+        {
+            {0xe4, 0x4e, 0x00, 0x00, 0x00, 0xff},
+            {0x3e, 0xe3, 0x00, 0x00, 0x00, 0xff},
+            {0x43, 0x34, 0x00, 0x00, 0x00, 0xff},
+            {0x4e, 0x34, 0x00, 0x00, 0x00, 0xff},
+            {0x4e, 0x34, 0x00, 0x00, 0x00, 0xff}
+        },
+        {
+            {0x0e, 0x44, 0xe0, 0xf0, 0x00, 0x0f},
+            {0x03, 0xee, 0x30, 0xf0, 0x00, 0x0f},
+            {0x04, 0x33, 0x40, 0xf0, 0x00, 0x0f},
+            {0x04, 0xe3, 0x40, 0xf0, 0x00, 0x0f},
+            {0x04, 0xe3, 0x40, 0xf0, 0x00, 0x0f}
+        }
+    }
 };
 
+/* The bonuses stay on their first frame and shimmer through the palette, see effects::update(). Bonus2-4 are no
+ * longer reached, their tiles only keep the element IDs in place. */
 const AnimationSequence animSequences[] = {
   /* None */ {ElementID::None, 0},
   /* Stone */ {ElementID::Stone, 0},
@@ -65,10 +602,10 @@ const AnimationSequence animSequences[] = {
   /* Bomb2 */ {ElementID::Bomb3, 2},
   /* Bomb3 */ {ElementID::Bomb4, 2},
   /* Bomb4 */ {ElementID::Bomb1, 2},
-  /* Bonus1 */ {ElementID::Bonus2, 3},
-  /* Bonus2 */ {ElementID::Bonus3, 3},
-  /* Bonus3 */ {ElementID::Bonus4, 3},
-  /* Bonus4 */ {ElementID::Bonus1, 3},
+  /* Bonus1 */ {ElementID::Bonus1, 0},
+  /* Bonus2 */ {ElementID::Bonus1, 0},
+  /* Bonus3 */ {ElementID::Bonus1, 0},
+  /* Bonus4 */ {ElementID::Bonus1, 0},
   /* Destroyed1 */ {ElementID::Destroyed2, 1},
   /* Destroyed2 */ {ElementID::Destroyed3, 1},
   /* Destroyed3 */ {ElementID::Destroyed4, 1},
@@ -99,15 +636,80 @@ const AnimationSequence animSequences[] = {
 static_assert(sizeof(animSequences) / sizeof(animSequences[0]) == static_cast<size_t>(tileset::ElementID::Count));
 static_assert(static_cast<size_t>(tileset::ElementID::Count) <= context::game::BLOCK_MASK);
 
-void draw(Image& tileset, uint16_t x, uint16_t y, ElementID elementID) {
-    gb.display.drawImage(x, y,
-            tileset,
-            static_cast<uint8_t>(elementID) * BLOCK_WIDTH + 2, 0,
-            BLOCK_WIDTH, BLOCK_HEIGHT);
+const size_t TILE_ROW_BYTES = BLOCK_WIDTH / 2;
+
+/* A shift of two pixels is a whole byte, so the pixel parity of x is the only shift that matters */
+const size_t NUM_SHIFTS = 2;
+const size_t SHIFTED_ROW_BYTES = TILE_ROW_BYTES + 1;
+
+/* Every tile is stored whole in the atlas, pre-shifted, its rows padded to whole bytes and followed by the
+ * framebuffer bits to keep (color 0 is transparent) */
+static_assert(sizeof(tilesetAtlas) / sizeof(tilesetAtlas[0]) == static_cast<size_t>(ElementID::Count));
+static_assert(sizeof(tilesetAtlas[0]) / sizeof(tilesetAtlas[0][0]) == NUM_SHIFTS);
+static_assert(sizeof(tilesetAtlas[0][0]) / sizeof(tilesetAtlas[0][0][0]) == BLOCK_HEIGHT);
+static_assert(sizeof(tilesetAtlas[0][0][0]) == 2 * SHIFTED_ROW_BYTES);
+
+/* The blitter is specialized for 4x5 tiles */
+static_assert(BLOCK_WIDTH == 4 && BLOCK_HEIGHT == 5);
+
+static inline void blitRow(uint8_t* dest, const uint8_t* src, size_t bytes) {
+    const uint8_t* keep = src + SHIFTED_ROW_BYTES;
+    for (size_t ix = 0; ix < bytes; ix++) {
+        dest[ix] = (dest[ix] & keep[ix]) | src[ix];
+    }
+}
+
+void draw(uint16_t x, uint16_t y, ElementID elementID) {
+    if (elementID == ElementID::None) {
+        return;
+    }
+
+    uint8_t* framebuffer = reinterpret_cast<uint8_t*>(gb.display._buffer);
+
+    /* Partially visible tiles are clipped row by row; x and y may be negative */
+    if (x > SCREEN_WIDTH - BLOCK_WIDTH || y > SCREEN_HEIGHT - BLOCK_HEIGHT) {
+        for (uint8_t row = 0; row < BLOCK_HEIGHT; row++) {
+            const int16_t lineY = static_cast<int16_t>(y) + row;
+            if (lineY >= 0 && lineY < (int16_t)SCREEN_HEIGHT) {
+                drawRow(framebuffer + lineY * (SCREEN_WIDTH / 2), static_cast<int16_t>(x), elementID, row);
+            }
+        }
+        return;
+    }
+
+    /* On odd x the 4 pixels span 3 bytes */
+    const uint8_t (*src)[2 * SHIFTED_ROW_BYTES] = tilesetAtlas[static_cast<uint8_t>(elementID)][x & 0x01];
+    const size_t bytes = TILE_ROW_BYTES + (x & 0x01);
+    uint8_t* dest = framebuffer + y * (SCREEN_WIDTH / 2) + (x >> 1);
+
+    for (size_t row = 0; row < BLOCK_HEIGHT; row++) {
+        blitRow(dest, src[row], bytes);
+        dest += SCREEN_WIDTH / 2;
+    }
 }
 
-void load(Image& tileset) {
-    tileset.init(tilesetData);
+void drawRow(uint8_t* line, int16_t x, ElementID elementID, uint8_t row) {
+    if (elementID == ElementID::None || x <= -(int16_t)BLOCK_WIDTH || x >= (int16_t)SCREEN_WIDTH) {
+        return;
+    }
+
+    const uint8_t* src = tilesetAtlas[static_cast<uint8_t>(elementID)][0][row];
+
+    if (x < 0 || x > (int16_t)(SCREEN_WIDTH - BLOCK_WIDTH)) {
+        for (int16_t px = 0; px < (int16_t)BLOCK_WIDTH; px++) {
+            if (x + px < 0 || x + px >= (int16_t)SCREEN_WIDTH) {
+                continue;
+            }
+            uint8_t color = (src[px >> 1] >> ((px & 0x01) ? 0 : 4)) & 0x0F;
+            if (color) {
+                uint8_t& dest = line[(x + px) >> 1];
+                dest = ((x + px) & 0x01) ? (dest & 0xF0) | color : (dest & 0x0F) | (color << 4);
+            }
+        }
+        return;
+    }
+
+    blitRow(line + (x >> 1), tilesetAtlas[static_cast<uint8_t>(elementID)][x & 0x01][row], TILE_ROW_BYTES + (x & 0x01));
 }
 
 void applyPalette(uint8_t paletteSlot, uint8_t firstRow, uint8_t lastRow) {
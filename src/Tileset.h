@@ -52,8 +52,10 @@ struct AnimationSequence {
 extern const AnimationSequence animSequences[];
 extern const uint16_t palette[];
 
-void load(Image& tileset);
-void draw(Image& tileset, uint16_t x, uint16_t y, ElementID id);
+/* Draws a tile into the framebuffer, clipping it if it is partially visible */
+void draw(uint16_t x, uint16_t y, ElementID id);
+/* Draws a single row of a tile into a framebuffer line, clipping it horizontally */
+void drawRow(uint8_t* line, int16_t x, ElementID id, uint8_t row);
 void applyPalette(uint8_t paletteSlot, uint8_t firstRow, uint8_t lastRow);
 
 static inline void updateAnimation(ElementID& element) {
@@ -28,13 +28,11 @@
 #include "Gamebuino-Meta-ADTCRV.h"
 #include <stdint.h>
 #include "Tileset.h"
+#include "Raster.h"
+#include "StaticText.h"
 #include "TitleSoundtrack.h"
-#include "utility/Graphics/font3x5.c"
-#include "font4x7.c"
-
-namespace spaceshoot {
-    extern Image tileSet;
-}
+#include "Font3x5.h"
+#include "Font4x7.h"
 
 namespace spaceshoot { namespace context { namespace titlescreen {
 
@@ -1337,20 +1335,23 @@ namespace spaceshoot { namespace context { namespace titlescreen {
         0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
     };
 
-    const char STR_DEVS2_1[] = "ORIGINAL GAME DEVELOPED";
-    const char STR_DEVS2_1a[] = "UNDER THE NAME OF";
-    const char STR_DEVS2_2[] = "FATALBOMB SOFTWARE";
-    const char STR_DEVS2_3[] = "IN ASSOCIATION WITH";
-    const char STR_DEVS2_4[] = "MAJSTERKOMPY RESEARCH GROUP";
+    static constexpr auto STR_DEVS2_1 = text::rasterize<4>("ORIGINAL GAME DEVELOPED");
+    static constexpr auto STR_DEVS2_1a = text::rasterize<4>("UNDER THE NAME OF");
+    static constexpr auto STR_DEVS2_2 = text::rasterize<4, 1, 2>("FATALBOMB SOFTWARE");
+    static constexpr auto STR_DEVS2_3 = text::rasterize<4>("IN ASSOCIATION WITH");
+    static constexpr auto STR_DEVS2_4 = text::rasterize<4, 1, 3>("MAJSTERKOMPY RESEARCH GROUP");
 
 #define TIMELINE(start,end) if (frame_index >= start and frame_index <= end)
     void run() {
         uint16_t pal[16];
 
-        gb.tft.colorCells.enabled = false;
+        /* A single palette for all the lines, so that only the lines that changed are sent to the panel */
+        memcpy(pal, gameLogoPalette, sizeof(pal));
+        gb.tft.colorCells.enabled = true;
+        gb.tft.colorCells.palettes[0] = (Color*)pal;
+        memset(gb.tft.colorCells.paletteToLine, 0, SCREEN_HEIGHT);
         Image img;
 
-        gb.display.setPalette(reinterpret_cast<const Color*>(gameLogoPalette));
         gb.display.drawImage(0, 0, img);
 
         uint32_t frame_index = 0;
@@ -1369,7 +1370,6 @@ namespace spaceshoot { namespace context { namespace titlescreen {
 
             TIMELINE(0x001, 0x00A) {
                 paletteFadeFromBlack(pal, devLogoPalette, frame_index, 10);
-                gb.tft.setPalette((Color*)pal);
             }
 
             TIMELINE(0x040, 0x5F) {
@@ -1380,42 +1380,39 @@ namespace spaceshoot { namespace context { namespace titlescreen {
             }
             TIMELINE(0x60, 0x60) {
                 /* fast screen clear */
-                memset(gb.display._buffer + SCREEN_WIDTH * 100 / 2, 0x00, SCREEN_WIDTH * 8 / 2);
+                raster::fillRect(raster::framebuffer(), 0, 100, SCREEN_WIDTH, 8, 0);
             }
 
 
             TIMELINE(0x70, 0x7A) {
                 paletteFadeFromBlack(pal, devLogoPalette, 0x7A - frame_index, 10);
-                gb.tft.setPalette((Color*)pal);
             }
 
             TIMELINE(0x7C, 0x7C) {
-                gb.tft.setPalette(Gamebuino_Meta::defaultColorPalette);
+                memcpy(pal, Gamebuino_Meta::defaultColorPalette, sizeof(pal));
                 gb.display.clear();
             }
 
             TIMELINE(0x80, 0x80) {
-                setTextFormat(INDEX_LIGHTBLUE, 1, 1, font4x7);
-                gb.display.setColor(INDEX_LIGHTBLUE);
-                gb.display.print(80 - strlen(STR_DEVS2_1) * 5 / 2, 12, STR_DEVS2_1);
-                gb.display.print(80 - strlen(STR_DEVS2_1a) * 5 / 2, 20, STR_DEVS2_1a);
+                text::setColor(INDEX_LIGHTBLUE);
+                text::print(text::centered(STR_DEVS2_1), 12, STR_DEVS2_1);
+                text::print(text::centered(STR_DEVS2_1a), 20, STR_DEVS2_1a);
             }
             TIMELINE(0x84, 0x84) {
-                setTextFormat(INDEX_LIGHTGREEN, 1, 2, font4x7);
-                gb.display.print(80 - strlen(STR_DEVS2_2) * 5 / 2, 38, STR_DEVS2_2);
+                text::setColor(INDEX_LIGHTGREEN);
+                text::print(text::centered(STR_DEVS2_2), 38, STR_DEVS2_2);
             }
             TIMELINE(0x90, 0x90) {
-                setTextFormat(INDEX_LIGHTBLUE, 1, 1, font4x7);
-                gb.display.print(80 - strlen(STR_DEVS2_3) * 5 / 2, 76, STR_DEVS2_3);
+                text::setColor(INDEX_LIGHTBLUE);
+                text::print(text::centered(STR_DEVS2_3), 76, STR_DEVS2_3);
             }
             TIMELINE(0x98, 0x98) {
-                setTextFormat(INDEX_BEIGE, 1, 3, font4x7);
-                gb.display.print(80 - strlen(STR_DEVS2_4) * 5 / 2, 94, STR_DEVS2_4);
+                text::setColor(INDEX_BEIGE);
+                text::print(text::centered(STR_DEVS2_4), 94, STR_DEVS2_4);
             }
 
             TIMELINE(0xF0, 0xFA) {
                 paletteFadeFromBlack(pal, (const uint16_t*)Gamebuino_Meta::defaultColorPalette, 0xFA - frame_index, 10);
-                gb.tft.setPalette((Color*)pal);
             }
 
             TIMELINE(0xFC, 0xFC){
@@ -1424,7 +1421,7 @@ namespace spaceshoot { namespace context { namespace titlescreen {
 
             TIMELINE(0xFE, 0xFE) {
                 img.init(gameLogoData);
-                gb.display.setPalette((const Color*)gameLogoPalette);
+                memcpy(pal, gameLogoPalette, sizeof(pal));
             }
 
             TIMELINE(0x100, 0x100) {
@@ -1433,17 +1430,15 @@ namespace spaceshoot { namespace context { namespace titlescreen {
 
             TIMELINE(0x100, 0x10A){
                 paletteFadeFromBlack(pal, gameLogoPalette, frame_index - 0x100, 10);
-                gb.display.setPalette((Color*)pal);
             }
 
             TIMELINE(267, 267) {
-                gb.display.setColor(8);
+                setTextFormat((ColorIndex)8, 1, 3, font4x7);
                 gb.display.print(SCREEN_WIDTH - strlen(VERSION) * 4, 120, VERSION);
             }
 
             TIMELINE(268, 278) {
                 paletteFadeFromBlack(pal, gameLogoPalette, 278 - frame_index, 10);
-                gb.display.setPalette((Color*)pal);
             }
 
             processEvents();
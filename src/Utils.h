@@ -24,9 +24,11 @@
 #define SST_UTILS_H
 
 #include "Gamebuino-Meta-ADTCRV.h"
+#include "Panel.h"
 
+/* Ends the frame: sends it to the panel and waits for the next one */
 static inline void processEvents() {
-    while (!gb.update()) ;
+    spaceshoot::panel::update();
 }
 
 bool buttonPressed(Button button);
@@ -38,6 +40,18 @@ static inline void setTextFormat(ColorIndex color, uint8_t w, uint8_t h, const u
     gb.display.setFontSize(w, h);
 }
 
+/* FNV-1a over count words of data, continuing from hash (FNV_OFFSET for a new one) */
+const uint32_t FNV_OFFSET = 2166136261u;
+const uint32_t FNV_PRIME = 16777619u;
+
+template <typename T>
+static inline uint32_t hashFnv1a(uint32_t hash, const T* data, size_t count) {
+    for (size_t ix = 0; ix < count; ix++) {
+        hash = (hash ^ data[ix]) * FNV_PRIME;
+    }
+    return hash;
+}
+
 void paletteFadeFromBlack(uint16_t* dest, const uint16_t* src, unsigned int val, unsigned int max);
 void paletteSyncFadeToBlack(uint8_t firstPalette, uint8_t lastPalette, uint8_t fadeTime);
 